@@ -0,0 +1,85 @@
+extern "C" {
+#include "cec17_test_func.h"
+}
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Benchmark of the kernels generated for each dimension against the generic
+ * ones, evaluating the solutions one by one and in blocks.
+ */
+
+// Milliseconds to evaluate all the solutions repeats times
+static double time_evaluation(cec17_context *ctx, vector<double> &sol,
+                              vector<double> &fitness, int dim, int block,
+                              int repeats) {
+  int num_solutions = fitness.size();
+  auto start = chrono::steady_clock::now();
+
+  for (int r = 0; r < repeats; r++) {
+    for (int i = 0; i < num_solutions; i += block) {
+      cec17_context_evaluate(ctx, &sol[i * dim], &fitness[i], block);
+    }
+  }
+
+  return chrono::duration<double, milli>(chrono::steady_clock::now() - start)
+      .count();
+}
+
+int main() {
+  int dims[] = {2, 10, 20, 30, 50, 100};
+  int funcids[] = {1, 5, 10, 21};
+  int num_solutions = 256;
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<> dis(-100.0, 100.0);
+
+  cout << setw(4) << "F" << setw(5) << "D" << setw(7) << "block" << setw(12)
+       << "generic ms" << setw(12) << "fixed ms" << setw(9) << "speedup"
+       << endl;
+
+  for (int dim : dims) {
+    vector<double> sol(num_solutions * dim);
+    vector<double> fitness(num_solutions);
+    // Around 2e7 multiplications of the rotations for each measure
+    int repeats = 20000000 / (num_solutions * dim * dim) + 1;
+
+    for (auto &value : sol) {
+      value = dis(gen);
+    }
+
+    for (int funcid : funcids) {
+      if (dim == 2 && ((funcid >= 17 && funcid <= 22) || funcid >= 29)) {
+        continue; // not defined for D=2
+      }
+
+      cec17_context *ctx = cec17_context_create(funcid, dim);
+
+      if (ctx == NULL) {
+        continue;
+      }
+
+      for (int block : {1, 32}) {
+        cec17_context_set_flags(ctx, 0);
+        double generic =
+            time_evaluation(ctx, sol, fitness, dim, block, repeats);
+        cec17_context_set_flags(ctx, CEC17_FLAG_FIXED);
+        double specialised =
+            time_evaluation(ctx, sol, fitness, dim, block, repeats);
+
+        cout << setw(4) << funcid << setw(5) << dim << setw(7) << block
+             << fixed << setprecision(1) << setw(12) << generic << setw(12)
+             << specialised << setprecision(2) << setw(9)
+             << generic / specialised << defaultfloat << endl;
+      }
+
+      cec17_context_destroy(ctx);
+    }
+  }
+
+  return 0;
+}
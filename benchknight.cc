@@ -0,0 +1,75 @@
+#include "heap_allocs.h"
+#include "inc/castle.h"
+#include "inc/knight.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Benchmark of the knight operations of a CSEA generation: the crossover of
+ * every pair of castles, the mutation of the children, the castles they take
+ * and the copies of the best knight. It reports the heap allocations and the
+ * time of each generation, which are spent in the chromosomes alone.
+ */
+
+int main() {
+  int dims[] = {10, 30, 50, 100};
+  int population_size = 60, generations = 20;
+  int errors = 0;
+
+  cout << setw(5) << "D" << setw(14) << "allocs/gen" << setw(12) << "us/gen"
+       << endl;
+
+  for (int dim : dims) {
+    vector<Castle> population;
+    vector<Knight> children;
+    population.reserve(population_size);
+    children.reserve(population_size * (population_size - 1) / 2);
+    for (int i = 0; i < population_size; ++i) {
+      population.emplace_back(Knight(dim), (double)i);
+    }
+    Knight best = population[0].get_king();
+
+    unsigned long before = heap_allocs;
+    auto start = chrono::steady_clock::now();
+    for (int g = 0; g < generations; ++g) {
+      children.clear();
+      for (int i = 0; i < population_size; ++i) {
+        for (int j = i + 1; j < population_size; ++j) {
+          children.push_back(population[i].crossover(population[j]));
+        }
+      }
+      for (size_t k = 0; k < children.size(); ++k) {
+        children[k].mutate(0.005);
+        // A castle taken and a new best knight every few children
+        if (k % 7 == 0) {
+          population[k % population_size] = Castle(children[k], (double)k);
+          best = children[k];
+        }
+      }
+    }
+    double us = chrono::duration<double, micro>(chrono::steady_clock::now() -
+                                                start)
+                    .count();
+    double allocs = (double)(heap_allocs - before) / generations;
+
+    cout << setw(5) << dim << setw(14) << allocs << setw(12) << fixed
+         << setprecision(1) << us / generations << endl;
+    cout.unsetf(ios::floatfield);
+#if defined(__GLIBC__)
+    if (allocs != 0 && dim <= (int)Chromosome::inline_capacity) {
+      errors++;
+    }
+#endif
+    if (best.size() != dim) {
+      errors++;
+    }
+  }
+
+  cout << (errors == 0 ? "OK" : "FAILED") << endl;
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -1,103 +1,515 @@
 #include "cec17.h"
+#include "cec17_test_func.h"
+#include "cec17_trace.h"
 #include <assert.h>
+#include <fcntl.h>
+#include <math.h>
+#include <signal.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 
-void cec17_test_func(double *x, double *f, int nx, int mx, int func_num);
+#define MAX_RATIOS 14
+#define LINE_SIZE 64
+/* Sessions whose milestones are written at exit and on fatal signals */
+#define MAX_SESSIONS 256
 
-static int dimension;
-static int funcid;
-static int count;
-static int ratios[] = {1, 2, 3, 5, 10, 20, 30, 40, 50, 60, 70, 80, 90, 100};
-static int max_evals;
-static int max_ratios = 14;
-static int last_ratio = 0;
-static char fname[300];
-static double best;
-static char directory[30];
-static int print_output = 0;
+static const int ratios[MAX_RATIOS] = {1,  2,  3,  5,  10, 20, 30,
+                                       40, 50, 60, 70, 80, 90, 100};
+
+/*
+ * State of a run. The counter and the best fitness are atomic, so a session
+ * can be shared by several threads. Its milestone lines are kept in memory
+ * and written to fname only by cec17_session_flush, which is also called at
+ * exit and on fatal signals, so evaluating never touches the filesystem.
+ */
+struct cec17_session {
+  int funcid;
+  int dimension;
+  long max_evals;
+  int print_output;
+  char directory[30];
+  char fname[300];
+  atomic_long count;
+  _Atomic double best;
+  /* Line of each milestone, ready once its flag is set. They are written in
+     order, so a milestone waits for the previous ones */
+  char line[MAX_RATIOS][LINE_SIZE];
+  int line_size[MAX_RATIOS];
+  atomic_int ready[MAX_RATIOS];
+  atomic_int written;
+  atomic_int flushing;
+  /* Convergence trace, with a row every trace_every evaluations (0: at
+     every generation) and at every milestone */
+  cec17_trace_file *trace;
+  long trace_every;
+  atomic_int generation;
+  atomic_long traced; /* Evaluation of the last row */
+};
+
+static const char header[] = "funcid,dim,milestone,error\n";
+static const int fatal_signals[] = {SIGINT,  SIGTERM, SIGHUP,  SIGQUIT,
+                                    SIGABRT, SIGSEGV, SIGBUS, SIGFPE};
+
+/* Session of cec17_init, used by the functions without a session argument
+   unless the thread has chosen another one with cec17_use_session */
+static cec17_session default_session;
+static _Thread_local cec17_session *current_session = NULL;
+static _Atomic(cec17_session *) sessions[MAX_SESSIONS];
+
+static cec17_session *current(void) {
+  return current_session != NULL ? current_session : &default_session;
+}
+
+static void write_all(int fd, const char *data, size_t size) {
+  ssize_t written;
+
+  while (size > 0) {
+    written = write(fd, data, size);
+    if (written <= 0) {
+      return;
+    }
+    data += written;
+    size -= written;
+  }
+}
+
+/* Appends the ready lines to fname. It only makes async-signal-safe calls,
+   as it also runs from the signal handler, and skips the session if another
+   thread is already writing it */
+static int write_pending(cec17_session *s) {
+  int busy = 0, fd, k;
+
+  k = atomic_load(&s->written);
+  if (k >= MAX_RATIOS || !atomic_load(&s->ready[k])) {
+    return 1;
+  }
+  if (!atomic_compare_exchange_strong(&s->flushing, &busy, 1)) {
+    return 1;
+  }
+
+  fd = open(s->fname, O_WRONLY | O_APPEND | O_CREAT, 0644);
+  if (fd < 0) {
+    atomic_store(&s->flushing, 0);
+    return 0;
+  }
+
+  if (lseek(fd, 0, SEEK_END) == 0) {
+    write_all(fd, header, sizeof(header) - 1);
+  }
+  for (k = atomic_load(&s->written);
+       k < MAX_RATIOS && atomic_load(&s->ready[k]); k++) {
+    write_all(fd, s->line[k], s->line_size[k]);
+  }
+  close(fd);
+  atomic_store(&s->written, k);
+  atomic_store(&s->flushing, 0);
+  return 1;
+}
+
+static void report_error(const cec17_session *s) {
+  fprintf(stderr,
+          "Error, it cannot be possible to create file '%s', the "
+          "directory '%s' exists?\n",
+          s->fname, s->directory);
+}
+
+static int flush_trace(cec17_session *s) {
+  if (s->trace != NULL && !cec17_trace_flush(s->trace)) {
+    fprintf(stderr, "Error, it cannot be possible to write the trace of '%s'\n",
+            s->fname);
+    return 0;
+  }
+  return 1;
+}
+
+static void flush_at_exit(void) {
+  cec17_session *s;
+  int i;
+
+  if (!write_pending(&default_session)) {
+    report_error(&default_session);
+  }
+  flush_trace(&default_session);
+  for (i = 0; i < MAX_SESSIONS; i++) {
+    s = atomic_load(&sessions[i]);
+    if (s != NULL) {
+      if (!write_pending(s)) {
+        report_error(s);
+      }
+      flush_trace(s);
+    }
+  }
+}
+
+/* Writes the ready lines and the rows of the trace still in memory */
+static void flush_session_on_signal(cec17_session *s) {
+  write_pending(s);
+  if (s->trace != NULL) {
+    cec17_trace_flush_on_signal(s->trace);
+  }
+}
+
+static void flush_on_signal(int sig) {
+  cec17_session *s;
+  int i;
+
+  flush_session_on_signal(&default_session);
+  for (i = 0; i < MAX_SESSIONS; i++) {
+    s = atomic_load(&sessions[i]);
+    if (s != NULL) {
+      flush_session_on_signal(s);
+    }
+  }
+  signal(sig, SIG_DFL);
+  raise(sig);
+}
+
+/* Installed once, and only for the signals the program does not handle */
+static void install_flush_handlers(void) {
+  static atomic_int installed = 0;
+  struct sigaction action, previous;
+  size_t i;
+
+  if (atomic_exchange(&installed, 1)) {
+    return;
+  }
+  atexit(flush_at_exit);
+
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = flush_on_signal;
+  sigemptyset(&action.sa_mask);
+  for (i = 0; i < sizeof(fatal_signals) / sizeof(fatal_signals[0]); i++) {
+    if (sigaction(fatal_signals[i], NULL, &previous) == 0 &&
+        previous.sa_handler == SIG_DFL) {
+      sigaction(fatal_signals[i], &action, NULL);
+    }
+  }
+}
+
+static void session_reset(cec17_session *s, const char *algname, int fid,
+                          int size, long max_evals) {
+  int k;
 
-void cec17_init(const char *algname, int fid, int size) {
   assert(fid > 0 && fid <= 30);
   assert(size == 2 || size == 5 || size == 10 || size == 30 || size == 50 ||
          size == 100);
-  funcid = fid;
-  dimension = size;
-  count = 0;
-  last_ratio = 0;
+  s->funcid = fid;
+  s->dimension = size;
+  s->max_evals = max_evals > 0 ? max_evals : 10000L * size;
+  s->print_output = 0;
+  snprintf(s->directory, sizeof(s->directory), "results_%s", algname);
+  snprintf(s->fname, sizeof(s->fname), "%s%cresults_%d_%d.txt", s->directory,
+           PATH_SEPARATOR, fid, size);
+  atomic_store(&s->count, 0);
+  atomic_store(&s->best, INFINITY);
+  for (k = 0; k < MAX_RATIOS; k++) {
+    atomic_store(&s->ready[k], 0);
+  }
+  atomic_store(&s->written, 0);
+  atomic_store(&s->flushing, 0);
+  cec17_trace_close(s->trace);
+  s->trace = NULL;
+  s->trace_every = 0;
+  atomic_store(&s->generation, 0);
+  atomic_store(&s->traced, 0);
+}
 
-  sprintf(directory, "results_%s", algname);
-  sprintf(fname, "%s%cresults_%d_%d.txt", directory, PATH_SEPARATOR, fid, size);
-  print_output = 0;
-  max_evals = 10000 * dimension;
+void cec17_init(const char *algname, int fid, int size) {
+  /* The lines of the previous run go to its own file */
+  cec17_session_flush(&default_session);
+  install_flush_handlers();
+  session_reset(&default_session, algname, fid, size, 0);
 }
 
-void cec17_print_output(void) { print_output = 1; }
+cec17_session *cec17_session_init(const char *algname, int fid, int size,
+                                  long max_evals) {
+  cec17_session *s = (cec17_session *)calloc(1, sizeof(cec17_session));
+  cec17_session *empty;
+  int i;
 
-double cec17_error(double fitness) {
-  const double optimum = funcid * 100;
+  if (s == NULL) {
+    fprintf(stderr, "Error: there is insufficient memory available!\n");
+    return NULL;
+  }
+  session_reset(s, algname, fid, size, max_evals);
+  install_flush_handlers();
+  /* Without a free slot the lines are only written by the session itself */
+  for (i = 0; i < MAX_SESSIONS; i++) {
+    empty = NULL;
+    if (atomic_compare_exchange_strong(&sessions[i], &empty, s)) {
+      break;
+    }
+  }
+  return s;
+}
+
+void cec17_session_destroy(cec17_session *s) {
+  cec17_session *registered;
+  int i;
+
+  if (s == NULL) {
+    return;
+  }
+  for (i = 0; i < MAX_SESSIONS; i++) {
+    registered = s;
+    if (atomic_compare_exchange_strong(&sessions[i], &registered, NULL)) {
+      break;
+    }
+  }
+  if (current_session == s) {
+    current_session = NULL;
+  }
+  cec17_session_flush(s);
+  cec17_trace_close(s->trace);
+  free(s);
+}
+
+cec17_session *cec17_use_session(cec17_session *s) {
+  cec17_session *previous = current_session;
+
+  current_session = s;
+  return previous;
+}
+
+void cec17_session_flush(cec17_session *s) {
+  if (!write_pending(s)) {
+    report_error(s);
+    exit(1);
+  }
+  if (!flush_trace(s)) {
+    exit(1);
+  }
+}
+
+void cec17_flush(void) { cec17_session_flush(current()); }
+
+void cec17_session_print_output(cec17_session *s) { s->print_output = 1; }
+
+void cec17_print_output(void) { cec17_session_print_output(current()); }
+
+double cec17_session_error(const cec17_session *s, double fitness) {
+  const double optimum = s->funcid * 100;
   assert(fitness >= optimum);
   return fitness - optimum;
 }
 
-double cec17_fitness(double *sol) {
-  double fit;
-  static FILE *output = NULL;
-  int ratio;
+double cec17_error(double fitness) {
+  return cec17_session_error(current(), fitness);
+}
 
-  cec17_test_func(sol, &fit, dimension, 1, funcid);
-  count += 1;
+long cec17_session_evaluations(cec17_session *s) {
+  long count = atomic_load(&s->count);
 
-  if (count > max_evals) {
-    fprintf(stderr, "Warning: evaluation will be ignored\n");
-    return fit;
+  return count < s->max_evals ? count : s->max_evals;
+}
+
+double cec17_session_best(cec17_session *s) { return atomic_load(&s->best); }
+
+int cec17_session_trace(cec17_session *s, const char *fname, long every) {
+  char path[300];
+
+  if (fname == NULL) {
+    snprintf(path, sizeof(path), "%s%ctrace_%d_%d.bin", s->directory,
+             PATH_SEPARATOR, s->funcid, s->dimension);
+    fname = path;
+  }
+  cec17_trace_close(s->trace);
+  s->trace_every = every > 0 ? every : 0;
+  s->trace = cec17_trace_open(fname, s->funcid, s->dimension, s->max_evals);
+  if (s->trace == NULL) {
+    fprintf(stderr, "Error, it cannot be possible to create the trace '%s'\n",
+            fname);
+    return 0;
   }
+  return 1;
+}
+
+int cec17_trace(const char *fname, long every) {
+  return cec17_session_trace(current(), fname, every);
+}
 
-  if (count == 1 || fit < best) {
-    best = fit;
+static void trace_row(cec17_session *s, long n) {
+  double error = atomic_load(&s->best) - s->funcid * 100;
+
+  atomic_store(&s->traced, n);
+  cec17_trace_add(s->trace, n, error, atomic_load(&s->generation));
+}
+
+void cec17_session_generation(cec17_session *s, int generation) {
+  atomic_store(&s->generation, generation);
+  if (s->trace != NULL && s->trace_every == 0) {
+    long n = cec17_session_evaluations(s);
+
+    /* The evaluation may already have the row of a milestone */
+    if (n > 0 && n != atomic_load(&s->traced)) {
+      trace_row(s, n);
+    }
   }
+}
 
-  ratio = count * 100 / max_evals;
+void cec17_generation(int generation) {
+  cec17_session_generation(current(), generation);
+}
 
-  if (ratio >= ratios[last_ratio]) {
-    if (output == NULL && print_output == 0) {
-      int exists = 0;
-      FILE *ver = fopen(fname, "r");
-      if (ver != NULL) {
-        exists = 1;
-        fclose(ver);
-      }
+/* Keeps the line of a milestone until the session is flushed */
+static void add_milestone(cec17_session *s, int k, long ratio) {
+  double error = cec17_session_error(s, atomic_load(&s->best));
 
-      output = fopen(fname, "a");
+  if (s->print_output == 1) {
+    printf("%d,%d,%ld,%e\n", s->funcid, s->dimension, ratio, error);
+    fflush(stdout);
+    return;
+  }
+  s->line_size[k] = snprintf(s->line[k], LINE_SIZE, "%d,%d,%ld,%e\n",
+                             s->funcid, s->dimension, ratio, error);
+  atomic_store(&s->ready[k], 1);
+}
 
-      if (output == NULL) {
-        fprintf(stderr,
-                "Error, it cannot be possible to create file '%s', the "
-                "directory '%s' exists?\n",
-                fname, directory);
-        exit(1);
-      }
+/* Accounts for one evaluation: counter, best so far and milestones. Every
+   evaluation gets its own number, so each milestone is reached by only one
+   of the threads sharing the session */
+static void record_fitness(cec17_session *s, double fit) {
+  long n = atomic_fetch_add(&s->count, 1) + 1;
+  double best = atomic_load(&s->best);
+  long before, ratio;
+  int k, milestone = 0;
 
-      if (!exists) {
-        fprintf(output, "funcid,dim,milestone,error\n");
-      }
+  if (n > s->max_evals) {
+    fprintf(stderr, "Warning: evaluation will be ignored\n");
+    return;
+  }
+
+  while (fit < best && !atomic_compare_exchange_weak(&s->best, &best, fit)) {
+  }
+
+  before = (n - 1) * 100 / s->max_evals;
+  ratio = n * 100 / s->max_evals;
+  for (k = 0; k < MAX_RATIOS && ratios[k] <= ratio; k++) {
+    if (ratios[k] > before) {
+      add_milestone(s, k, ratio);
+      milestone = 1;
     }
+  }
 
-    if (print_output == 1) {
-      printf("%d,%d,%d,%e\n", funcid, dimension, ratio, cec17_error(best));
-      fflush(stdout);
-    } else {
-      fprintf(output, "%d,%d,%d,%e\n", funcid, dimension, ratio,
-              cec17_error(best));
-      fclose(output);
-      output = NULL;
+  if (s->trace != NULL &&
+      (milestone || (s->trace_every > 0 && n % s->trace_every == 0))) {
+    trace_row(s, n);
+  }
+}
+
+void cec17_session_finish(cec17_session *s) {
+  long n = atomic_exchange(&s->count, s->max_evals);
+  long ratio;
+  int k;
+
+  if (n >= s->max_evals) {
+    return;
+  }
+  /* The error stays the same until the end of the budget, so the trace gets
+     the rows of the missing milestones too */
+  ratio = n * 100 / s->max_evals;
+  for (k = 0; k < MAX_RATIOS; k++) {
+    if (ratios[k] > ratio) {
+      add_milestone(s, k, ratios[k]);
+      if (s->trace != NULL) {
+        trace_row(s, (ratios[k] * s->max_evals + 99) / 100);
+      }
     }
-    last_ratio += 1;
+  }
+}
+
+void cec17_finish(void) { cec17_session_finish(current()); }
+
+/* The default session keeps the context (and the threads) of
+   cec17_test_func, any other one uses a context per thread */
+static cec17_context *session_context(cec17_session *s) {
+  if (s == &default_session) {
+    return cec17_default_context(s->funcid, s->dimension);
+  }
+  return cec17_thread_context(s->funcid, s->dimension);
+}
+
+static void session_evaluate(cec17_session *s, double *x, double *f, int mx) {
+  cec17_context *ctx;
+  int i;
 
-    if (last_ratio >= max_ratios) {
-      last_ratio = 0;
+  if (s == &default_session) {
+    cec17_test_func(x, f, s->dimension, mx, s->funcid);
+    return;
+  }
+  ctx = session_context(s);
+  if (ctx == NULL) {
+    for (i = 0; i < mx; i++) {
+      f[i] = 0.0;
     }
+    return;
   }
+  cec17_context_evaluate(ctx, x, f, mx);
+}
+
+double cec17_session_fitness(cec17_session *s, double *sol) {
+  double fit;
+
+  session_evaluate(s, sol, &fit, 1);
+  record_fitness(s, fit);
+  return fit;
+}
+
+double cec17_fitness(double *sol) {
+  return cec17_session_fitness(current(), sol);
+}
+
+void cec17_session_record(cec17_session *s, double fitness) {
+  record_fitness(s, fitness);
+}
 
+void cec17_record(double fitness) { record_fitness(current(), fitness); }
+
+void cec17_session_fitness_batch(cec17_session *s, const double *X, double *f,
+                                 int num_solutions) {
+  int i;
+
+  session_evaluate(s, (double *)X, f, num_solutions);
+
+  for (i = 0; i < num_solutions; i++) {
+    record_fitness(s, f[i]);
+  }
+}
+
+void cec17_fitness_batch(const double *X, double *f, int num_solutions) {
+  cec17_session_fitness_batch(current(), X, f, num_solutions);
+}
+
+int cec17_state_size(void) {
+  cec17_context *ctx = session_context(current());
+
+  return ctx != NULL ? cec17_context_state_size(ctx) : 0;
+}
+
+double cec17_fitness_state(double *sol, double *state) {
+  cec17_session *s = current();
+  cec17_context *ctx = session_context(s);
+  double fit = 0.0;
+
+  if (ctx != NULL) {
+    cec17_context_evaluate_state(ctx, sol, &fit, state);
+  }
+  record_fitness(s, fit);
+  return fit;
+}
+
+double cec17_fitness_delta(double *sol, double *state, const int *changed,
+                           int num_changed) {
+  cec17_session *s = current();
+  cec17_context *ctx = session_context(s);
+  double fit = 0.0;
+
+  if (ctx != NULL) {
+    cec17_context_evaluate_delta(ctx, sol, &fit, state, changed, num_changed);
+  }
+  record_fitness(s, fit);
   return fit;
 }
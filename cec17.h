@@ -10,7 +10,8 @@
 
 
 /**
- * Inicia la función de evaluación y la dimensión.
+ * Inicia la función de evaluación y la dimensión. Antes escribe los hitos
+ * pendientes de la ejecución anterior (ver cec17_flush).
  * @param algname (results will be copy to results_algname directory).
  * @param funcid debe ser entre 1 y 30.
  * @param dimension debe ser 2, 5, 10, 30, o 50.
@@ -22,6 +23,120 @@ void cec17_init(const char *algname, int funcid, int dimension);
  */
 void cec17_print_output(void);
 
+/**
+ * Escribe en el fichero de resultados los hitos pendientes. Los hitos se
+ * guardan en memoria mientras se evalúa y se escriben al llamar a esta
+ * función, al iniciar otra ejecución con cec17_init, al terminar el programa
+ * o al recibir una señal que lo termina (SIGINT, SIGTERM, SIGSEGV...).
+ * Termina el programa si no puede crearse el fichero.
+ */
+void cec17_flush(void);
+
+/**
+ * Sesión de evaluación: función, dimensión, contador y límite de
+ * evaluaciones, mejor fitness e hitos de una ejecución. El contador y el
+ * mejor valor se actualizan de forma atómica, de modo que una sesión puede
+ * usarse desde varios hilos a la vez (cada hilo evalúa con su propio
+ * contexto), y en un mismo proceso pueden existir tantas ejecuciones
+ * independientes como sesiones.
+ *
+ * cec17_init usa una sesión por defecto, que es la que usan las funciones sin
+ * argumento de sesión salvo que el hilo elija otra con cec17_use_session. La
+ * sesión por defecto evalúa con cec17_test_func, por lo que no debe usarse
+ * desde varios hilos a la vez.
+ */
+typedef struct cec17_session cec17_session;
+
+/**
+ * Crea una sesión, como cec17_init pero sin sustituir la ejecución actual.
+ * @param algname (results will be copy to results_algname directory).
+ * @param funcid debe ser entre 1 y 30.
+ * @param dimension debe ser 2, 5, 10, 30, o 50.
+ * @param max_evals evaluaciones permitidas, o 0 para 10000 * dimension. Las
+ * que lo superan no se cuentan.
+ * @return sesión, o NULL si no hay memoria.
+ */
+cec17_session *cec17_session_init(const char *algname, int funcid,
+                                  int dimension, long max_evals);
+
+/**
+ * Escribe los hitos pendientes de la sesión y la libera.
+ */
+void cec17_session_destroy(cec17_session *session);
+
+/**
+ * Elige la sesión que usan desde el hilo que llama las funciones sin
+ * argumento de sesión (cec17_fitness, cec17_fitness_batch, cec17_error...),
+ * de modo que un algoritmo escrito sobre ellas puede ejecutarse en varios
+ * hilos, cada uno con su sesión.
+ * @param session sesión, o NULL para volver a la sesión por defecto.
+ * @return sesión elegida antes (NULL si era la sesión por defecto).
+ */
+cec17_session *cec17_use_session(cec17_session *session);
+
+/**
+ * Como cec17_print_output, cec17_flush, cec17_error, cec17_fitness,
+ * cec17_record y cec17_fitness_batch, sobre una sesión concreta.
+ */
+void cec17_session_print_output(cec17_session *session);
+void cec17_session_flush(cec17_session *session);
+double cec17_session_error(const cec17_session *session, double fitness);
+double cec17_session_fitness(cec17_session *session, double *sol);
+void cec17_session_record(cec17_session *session, double fitness);
+void cec17_session_fitness_batch(cec17_session *session, const double *X,
+                                 double *f, int num_solutions);
+
+/**
+ * Termina la ejecución antes de agotar las evaluaciones (por ejemplo, al
+ * alcanzar el error objetivo): añade los hitos que faltan con el mejor error
+ * actual, como si el resto de evaluaciones no lo mejorasen, de modo que el
+ * fichero de resultados tiene siempre todos los hitos. Las evaluaciones se
+ * dan por agotadas, así que las posteriores se ignoran.
+ */
+void cec17_session_finish(cec17_session *session);
+
+/**
+ * Como cec17_session_finish, sobre la sesión del hilo que llama.
+ */
+void cec17_finish(void);
+
+/**
+ * Número de evaluaciones contadas por la sesión (como mucho max_evals).
+ */
+long cec17_session_evaluations(cec17_session *session);
+
+/**
+ * Mejor fitness evaluado en la sesión (infinito si aún no hay ninguno).
+ */
+double cec17_session_best(cec17_session *session);
+
+/**
+ * Empieza a guardar la traza de convergencia de la sesión (ver
+ * cec17_trace.h), cerrando la anterior si la hay. La traza se escribe por
+ * bloques, al llamar a cec17_session_flush y al terminar la sesión o el
+ * programa.
+ * @param fname fichero de la traza, o NULL para trace_funcid_dimension.bin en
+ * el directorio de resultados.
+ * @param every guarda una fila cada every evaluaciones, o 0 para guardarla en
+ * cada generación (ver cec17_session_generation). Siempre se guarda una fila
+ * en las evaluaciones que alcanzan un hito.
+ * @return 1 si se ha creado, 0 si no puede abrirse el fichero.
+ */
+int cec17_session_trace(cec17_session *session, const char *fname, long every);
+
+/**
+ * Indica la generación del algoritmo, que se guarda en las filas de la traza
+ * (y, si la traza es por generaciones, añade una fila).
+ */
+void cec17_session_generation(cec17_session *session, int generation);
+
+/**
+ * Como cec17_session_trace y cec17_session_generation, sobre la sesión del
+ * hilo que llama.
+ */
+int cec17_trace(const char *fname, long every);
+void cec17_generation(int generation);
+
 /**
  * Devuelve el error asociado al fitness.
  * @param fitness a comparar.
@@ -37,4 +152,51 @@ double cec17_error(double fitness);
  */
 double cec17_fitness(double *sol);
 
+/**
+ * Cuenta como una evaluación un fitness ya conocido (por ejemplo, guardado en
+ * una caché), actualizando el contador, el mejor valor y los hitos como
+ * cec17_fitness.
+ *
+ * @param fitness valor de una solución evaluada antes.
+ */
+void cec17_record(double fitness);
+
+/**
+ * Evalúa un conjunto de soluciones en una sola llamada. El contador de
+ * evaluaciones, el mejor valor y los hitos se actualizan como si se hubiese
+ * llamado a cec17_fitness con cada fila en orden. Los lotes grandes pueden
+ * evaluarse con varios hilos (ver cec17_set_threads).
+ *
+ * @param X matriz de num_solutions filas, de la dimensión de la función.
+ * @param f vector donde se guardan los num_solutions fitness.
+ * @param num_solutions número de soluciones.
+ */
+void cec17_fitness_batch(const double *X, double *f, int num_solutions);
+
+/**
+ * Tamaño del estado de evaluación de la función actual (ver
+ * cec17_context_state_size), o 0 si no lo admite.
+ */
+int cec17_state_size(void);
+
+/**
+ * Como cec17_fitness, guardando además el estado de evaluación de la solución.
+ *
+ * @param state vector de cec17_state_size() valores.
+ */
+double cec17_fitness_state(double *sol, double *state);
+
+/**
+ * Como cec17_fitness para una solución de la que solo han cambiado algunos
+ * genes desde que se guardó su estado, que se actualiza. El estado debe
+ * recalcularse con cec17_fitness_state tras unas 32 actualizaciones, o cuando
+ * cambie una cuarta parte de los genes o más, para que no se acumule el error
+ * de redondeo.
+ *
+ * @param changed índices de los genes cambiados.
+ * @param num_changed número de índices.
+ */
+double cec17_fitness_delta(double *sol, double *state, const int *changed,
+                           int num_changed);
+
 #endif
@@ -0,0 +1,337 @@
+#include "cec17_archive.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+ * Layout (native byte order):
+ *   header (64 bytes) | index (count entries) | data blocks
+ * Every data block starts at a multiple of ARCHIVE_ALIGN so that the
+ * matrices can be used in place once the file is mapped. The matrices are
+ * stored as cec17_load_text returns them, with the rows of the hybrid
+ * functions already shuffled (version 2).
+ */
+#define ARCHIVE_MAGIC "CEC17BIN"
+#define ARCHIVE_VERSION 2
+#define ARCHIVE_ENDIAN 0x01020304u
+#define ARCHIVE_ALIGN 64
+
+struct archive_header {
+  char magic[8];
+  uint32_t version;
+  uint32_t endian;
+  uint32_t count;
+  uint32_t reserved[11];
+};
+
+struct archive_entry {
+  int32_t funcid;
+  int32_t dimension;
+  int32_t kind;
+  int32_t reserved;
+  uint64_t offset;
+  uint64_t count;
+};
+
+static const int dimensions[] = {2, 10, 20, 30, 50, 100};
+static const int num_dimensions = 6;
+
+static const unsigned char *archive = NULL;
+static size_t archive_size = 0;
+static pthread_once_t archive_once = PTHREAD_ONCE_INIT;
+
+static size_t element_size(int kind) {
+  return kind == CEC17_ARCHIVE_SHUFFLE ? sizeof(int32_t) : sizeof(double);
+}
+
+static int archive_valid(const unsigned char *data, size_t size) {
+  const struct archive_header *header = (const struct archive_header *)data;
+  const struct archive_entry *entries;
+  uint32_t i;
+
+  if (size < sizeof(*header) ||
+      memcmp(header->magic, ARCHIVE_MAGIC, sizeof(header->magic)) != 0 ||
+      header->version != ARCHIVE_VERSION || header->endian != ARCHIVE_ENDIAN) {
+    return 0;
+  }
+
+  if (header->count > (size - sizeof(*header)) / sizeof(*entries)) {
+    return 0;
+  }
+
+  entries = (const struct archive_entry *)(data + sizeof(*header));
+
+  for (i = 0; i < header->count; i++) {
+    uint64_t bytes = entries[i].count * element_size(entries[i].kind);
+
+    if (entries[i].offset % ARCHIVE_ALIGN != 0 || entries[i].offset > size ||
+        bytes > size - entries[i].offset) {
+      return 0;
+    }
+  }
+
+  return 1;
+}
+
+static void archive_map(void) {
+#if defined(_WIN32)
+  FILE *file = fopen(CEC17_ARCHIVE_FILE, "rb");
+  unsigned char *data;
+  long size;
+
+  if (file == NULL) {
+    return;
+  }
+
+  fseek(file, 0, SEEK_END);
+  size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  data = (unsigned char *)malloc(size > 0 ? size : 1);
+
+  if (data == NULL || fread(data, 1, size, file) != (size_t)size ||
+      !archive_valid(data, size)) {
+    fprintf(stderr, "Warning: ignoring invalid archive '%s'\n",
+            CEC17_ARCHIVE_FILE);
+    free(data);
+    fclose(file);
+    return;
+  }
+
+  fclose(file);
+  archive = data;
+  archive_size = size;
+#else
+  struct stat st;
+  void *data;
+  int fd = open(CEC17_ARCHIVE_FILE, O_RDONLY);
+
+  if (fd < 0) {
+    return;
+  }
+
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    close(fd);
+    return;
+  }
+
+  data = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+
+  if (data == MAP_FAILED) {
+    return;
+  }
+
+  if (!archive_valid((const unsigned char *)data, st.st_size)) {
+    fprintf(stderr, "Warning: ignoring invalid archive '%s'\n",
+            CEC17_ARCHIVE_FILE);
+    munmap(data, st.st_size);
+    return;
+  }
+
+  archive = (const unsigned char *)data;
+  archive_size = st.st_size;
+#endif
+}
+
+const void *cec17_archive_find(int funcid, int dimension, int kind,
+                               long count) {
+  const struct archive_header *header;
+  const struct archive_entry *entries;
+  uint32_t i;
+
+  pthread_once(&archive_once, archive_map);
+
+  if (archive == NULL) {
+    return NULL;
+  }
+
+  header = (const struct archive_header *)archive;
+  entries = (const struct archive_entry *)(archive + sizeof(*header));
+
+  for (i = 0; i < header->count; i++) {
+    if (entries[i].funcid == funcid && entries[i].dimension == dimension &&
+        entries[i].kind == kind) {
+      if (entries[i].count != (uint64_t)count) {
+        return NULL;
+      }
+      return archive + entries[i].offset;
+    }
+  }
+
+  return NULL;
+}
+
+static int file_exists(const char *fname) {
+  FILE *file = fopen(fname, "r");
+
+  if (file == NULL) {
+    return 0;
+  }
+
+  fclose(file);
+  return 1;
+}
+
+static int text_available(int funcid, int dimension) {
+  char fname[256];
+  long m_size, shift_size, shuffle_size;
+
+  cec17_data_sizes(funcid, dimension, &m_size, &shift_size, &shuffle_size);
+
+  sprintf(fname, "input_data/M_%d_D%d.txt", funcid, dimension);
+  if (!file_exists(fname)) {
+    return 0;
+  }
+
+  sprintf(fname, "input_data/shift_data_%d.txt", funcid);
+  if (!file_exists(fname)) {
+    return 0;
+  }
+
+  if (shuffle_size > 0) {
+    sprintf(fname, "input_data/shuffle_data_%d_D%d.txt", funcid, dimension);
+    if (!file_exists(fname)) {
+      return 0;
+    }
+  }
+
+  return 1;
+}
+
+int cec17_data_available(int funcid, int dimension) {
+  long m_size, shift_size, shuffle_size;
+
+  cec17_data_sizes(funcid, dimension, &m_size, &shift_size, &shuffle_size);
+
+  if (cec17_archive_find(funcid, dimension, CEC17_ARCHIVE_M, m_size) != NULL &&
+      cec17_archive_find(funcid, dimension, CEC17_ARCHIVE_SHIFT, shift_size) !=
+          NULL &&
+      (shuffle_size == 0 ||
+       cec17_archive_find(funcid, dimension, CEC17_ARCHIVE_SHUFFLE,
+                          shuffle_size) != NULL)) {
+    return 1;
+  }
+
+  return text_available(funcid, dimension);
+}
+
+static int write_block(FILE *file, struct archive_entry *entry, int funcid,
+                       int dimension, int kind, const void *data, long count) {
+  static const char padding[ARCHIVE_ALIGN] = {0};
+  long pos = ftell(file);
+  long pad = (ARCHIVE_ALIGN - pos % ARCHIVE_ALIGN) % ARCHIVE_ALIGN;
+
+  if (fwrite(padding, 1, pad, file) != (size_t)pad) {
+    return 0;
+  }
+
+  entry->funcid = funcid;
+  entry->dimension = dimension;
+  entry->kind = kind;
+  entry->reserved = 0;
+  entry->offset = pos + pad;
+  entry->count = count;
+
+  return fwrite(data, element_size(kind), count, file) == (size_t)count;
+}
+
+int cec17_archive_build(const char *filename) {
+  struct archive_header header;
+  struct archive_entry *entries;
+  int funcid, d, count = 0, problems = 0, ok = 1;
+  FILE *file;
+
+  if (sizeof(int) != sizeof(int32_t)) {
+    fprintf(stderr, "Error: the archive requires 32 bits integers\n");
+    return -1;
+  }
+
+  entries = (struct archive_entry *)calloc(30 * num_dimensions * 3,
+                                           sizeof(*entries));
+  if (entries == NULL) {
+    return -1;
+  }
+
+  for (funcid = 1; funcid <= 30; funcid++) {
+    for (d = 0; d < num_dimensions; d++) {
+      long m_size, shift_size, shuffle_size;
+
+      if (text_available(funcid, dimensions[d])) {
+        cec17_data_sizes(funcid, dimensions[d], &m_size, &shift_size,
+                         &shuffle_size);
+        count += shuffle_size > 0 ? 3 : 2;
+      }
+    }
+  }
+
+  file = fopen(filename, "wb");
+  if (file == NULL) {
+    fprintf(stderr, "Error, it cannot be possible to create file '%s'\n",
+            filename);
+    free(entries);
+    return -1;
+  }
+
+  /* Reserve space for the header and the index, written at the end */
+  memset(&header, 0, sizeof(header));
+  fwrite(&header, sizeof(header), 1, file);
+  fwrite(entries, sizeof(*entries), count, file);
+  count = 0;
+
+  for (funcid = 1; funcid <= 30 && ok; funcid++) {
+    for (d = 0; d < num_dimensions && ok; d++) {
+      int dimension = dimensions[d];
+      long m_size, shift_size, shuffle_size;
+      double *M = NULL, *OShift = NULL;
+      int *SS = NULL;
+
+      if (!text_available(funcid, dimension)) {
+        continue;
+      }
+
+      cec17_data_sizes(funcid, dimension, &m_size, &shift_size,
+                       &shuffle_size);
+      ok = cec17_load_text(funcid, dimension, &M, &OShift, &SS) &&
+           write_block(file, &entries[count++], funcid, dimension,
+                       CEC17_ARCHIVE_M, M, m_size) &&
+           write_block(file, &entries[count++], funcid, dimension,
+                       CEC17_ARCHIVE_SHIFT, OShift, shift_size) &&
+           (shuffle_size == 0 ||
+            write_block(file, &entries[count++], funcid, dimension,
+                        CEC17_ARCHIVE_SHUFFLE, SS, shuffle_size));
+      problems++;
+
+      free(M);
+      free(OShift);
+      free(SS);
+    }
+  }
+
+  memcpy(header.magic, ARCHIVE_MAGIC, sizeof(header.magic));
+  header.version = ARCHIVE_VERSION;
+  header.endian = ARCHIVE_ENDIAN;
+  header.count = count;
+
+  ok = ok && fseek(file, 0, SEEK_SET) == 0 &&
+       fwrite(&header, sizeof(header), 1, file) == 1 &&
+       fwrite(entries, sizeof(*entries), count, file) == (size_t)count;
+  ok = (fclose(file) == 0) && ok;
+  free(entries);
+
+  if (!ok) {
+    fprintf(stderr, "Error writing archive '%s'\n", filename);
+    remove(filename);
+    return -1;
+  }
+
+  return problems;
+}
@@ -0,0 +1,59 @@
+#ifndef _CEC17_ARCHIVE
+
+#define _CEC17_ARCHIVE 1
+
+/**
+ * Fichero empaquetado con los datos de input_data. Si existe, los contextos
+ * usan directamente sus datos (proyectados en memoria) en lugar de leer los
+ * ficheros de texto.
+ */
+#define CEC17_ARCHIVE_FILE "input_data/cec17.bin"
+
+/**
+ * Tipos de bloque guardados para cada función y dimensión.
+ */
+enum {
+  CEC17_ARCHIVE_M = 0,      /* matrices de rotación (double), con las filas
+                               de las funciones híbridas ya barajadas */
+  CEC17_ARCHIVE_SHIFT = 1,  /* vectores de desplazamiento (double) */
+  CEC17_ARCHIVE_SHUFFLE = 2 /* índices de barajado (int) */
+};
+
+/**
+ * Busca un bloque en el fichero empaquetado, proyectándolo la primera vez.
+ * @param kind tipo de bloque (CEC17_ARCHIVE_*).
+ * @param count número de elementos esperado.
+ * @return puntero de solo lectura a los datos, o NULL si no está disponible.
+ */
+const void *cec17_archive_find(int funcid, int dimension, int kind,
+                               long count);
+
+/**
+ * Genera el fichero empaquetado a partir de los ficheros de texto de
+ * input_data, para todas las funciones y dimensiones disponibles.
+ * @param filename fichero de salida.
+ * @return número de problemas guardados, o -1 si hay error.
+ */
+int cec17_archive_build(const char *filename);
+
+/**
+ * Indica si hay datos (empaquetados o en texto) para una función y dimensión.
+ */
+int cec17_data_available(int funcid, int dimension);
+
+/**
+ * Tamaño (en elementos) de los datos de una función y dimensión.
+ */
+void cec17_data_sizes(int func_num, int nx, long *m_size, long *shift_size,
+                      long *shuffle_size);
+
+/**
+ * Lee los datos de una función y dimensión desde los ficheros de texto. En
+ * las funciones híbridas (y las compuestas por híbridas) las filas de M se
+ * reordenan según los índices de barajado.
+ * @return 1 si se han leído, 0 si falta algún fichero.
+ */
+int cec17_load_text(int func_num, int nx, double **M, double **OShift,
+                    int **SS);
+
+#endif
@@ -0,0 +1,110 @@
+#include "cec17_fixed.h"
+#include <cstring>
+
+namespace {
+
+template <int D> void rotate(const double *x, double *xrot, const double *Mr) {
+  double v[D];
+
+  for (int j = 0; j < D; j++) {
+    v[j] = x[j];
+  }
+
+  for (int i = 0; i < D; i++) {
+    double sum = 0;
+
+    for (int j = 0; j < D; j++) {
+      sum = sum + v[j] * Mr[i * D + j];
+    }
+    xrot[i] = sum;
+  }
+}
+
+// Two lanes of the block, the width of SSE2: the accumulators of a row are
+// kept in CEC17_BLOCK / 2 registers with the same per-lane operations as the
+// scalar loop
+typedef double lane_pair __attribute__((vector_size(2 * sizeof(double))));
+
+template <int D>
+void rotate_block(const double *yt, int mx, const double *Mr, double *z) {
+  for (int i = 0; i < D; i++) {
+    lane_pair acc[CEC17_BLOCK / 2], v;
+    double sum[CEC17_BLOCK];
+
+#pragma GCC unroll 4
+    for (int p = 0; p < CEC17_BLOCK / 2; p++) {
+      acc[p] = lane_pair{0, 0};
+    }
+
+    for (int j = 0; j < D; j++) {
+      double m = Mr[i * D + j];
+
+#pragma GCC unroll 4
+      for (int p = 0; p < CEC17_BLOCK / 2; p++) {
+        memcpy(&v, &yt[j * CEC17_BLOCK + 2 * p], sizeof(v));
+        acc[p] = acc[p] + v * m;
+      }
+    }
+
+    memcpy(sum, acc, sizeof(sum));
+    for (int b = 0; b < mx; b++) {
+      z[b * D + i] = sum[b];
+    }
+  }
+}
+
+template <int D>
+void sr_block(const double *x, int mx, const double *Os, const double *Mr,
+              double sh_rate, double *block) {
+  double *y = block, *z = &block[CEC17_BLOCK * D],
+         *yt = &block[2 * CEC17_BLOCK * D];
+
+  for (int b = 0; b < CEC17_BLOCK; b++) {
+    for (int i = 0; i < D; i++) {
+      if (b < mx) {
+        y[b * D + i] = x[b * D + i] - Os[i];
+        y[b * D + i] = y[b * D + i] * sh_rate;
+        yt[i * CEC17_BLOCK + b] = y[b * D + i];
+      } else {
+        yt[i * CEC17_BLOCK + b] = 0.0;
+      }
+    }
+  }
+
+  rotate_block<D>(yt, mx, Mr, z);
+}
+
+template <int D> cec17_fixed_kernels kernels() {
+  cec17_fixed_kernels fixed;
+  fixed.rotate = rotate<D>;
+  fixed.sr_block = sr_block<D>;
+  fixed.rotate_block = rotate_block<D>;
+  return fixed;
+}
+
+} // namespace
+
+int cec17_fixed_lookup(int nx, cec17_fixed_kernels *fixed) {
+  switch (nx) {
+  case 2:
+    *fixed = kernels<2>();
+    return 1;
+  case 10:
+    *fixed = kernels<10>();
+    return 1;
+  case 20:
+    *fixed = kernels<20>();
+    return 1;
+  case 30:
+    *fixed = kernels<30>();
+    return 1;
+  case 50:
+    *fixed = kernels<50>();
+    return 1;
+  case 100:
+    *fixed = kernels<100>();
+    return 1;
+  default:
+    return 0;
+  }
+}
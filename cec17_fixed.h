@@ -0,0 +1,50 @@
+#ifndef _CEC17_FIXED
+
+#define _CEC17_FIXED 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Soluciones que se desplazan y rotan juntas en una evaluación por bloques.
+ */
+#define CEC17_BLOCK 8
+
+/**
+ * Versiones de las transformaciones O(D^2) de los kernels generadas para cada
+ * dimensión del CEC17 (2, 10, 20, 30, 50 y 100), de modo que el compilador
+ * conoce el tamaño de todos los bucles. Suman en el mismo orden que las
+ * genéricas, por lo que los resultados son idénticos.
+ */
+typedef struct cec17_fixed_kernels {
+  /**
+   * Igual que rotatefunc: xrot = Mr * x.
+   */
+  void (*rotate)(const double *x, double *xrot, const double *Mr);
+
+  /**
+   * Igual que sr_block: desplaza, escala y rota mx <= CEC17_BLOCK soluciones
+   * dejando en block las filas de y, las de z y los valores de y traspuestos.
+   */
+  void (*sr_block)(const double *x, int mx, const double *Os, const double *Mr,
+                   double sh_rate, double *block);
+
+  /**
+   * Igual que rotate_block: rota mx <= CEC17_BLOCK soluciones dadas por sus
+   * valores traspuestos en yt, dejando en z sus filas.
+   */
+  void (*rotate_block)(const double *yt, int mx, const double *Mr, double *z);
+} cec17_fixed_kernels;
+
+/**
+ * Busca las versiones para una dimensión.
+ * @return 1 si existen, 0 si hay que usar las genéricas.
+ */
+int cec17_fixed_lookup(int nx, cec17_fixed_kernels *kernels);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,161 @@
+#include "cec17_profile.h"
+#include <stdatomic.h>
+#include <string.h>
+
+#define MAX_FUNCS 30
+#define NUM_DIMS 7
+
+static const int dimensions[NUM_DIMS] = {2, 5, 10, 20, 30, 50, 100};
+
+/* The counters are atomic so that the threads of the parallel batches and of
+   the sessions can record at the same time */
+struct profile_slot {
+  atomic_ullong calls;
+  atomic_ullong evaluations;
+  atomic_ullong cycles;
+  atomic_ullong max_cycles;
+  atomic_ullong histogram[CEC17_PROFILE_BUCKETS];
+};
+
+int cec17_profile_active = 0;
+
+static struct profile_slot slots[MAX_FUNCS][NUM_DIMS];
+/* Counter and clock when the profiler was enabled, to convert cycles */
+static uint64_t start_cycles;
+static struct timespec start_time;
+
+static int dimension_index(int nx) {
+  int d;
+
+  for (d = 0; d < NUM_DIMS; d++) {
+    if (dimensions[d] == nx) {
+      return d;
+    }
+  }
+  return -1;
+}
+
+static int bucket(uint64_t cycles) {
+  int b = 0;
+
+  while (cycles > 1 && b < CEC17_PROFILE_BUCKETS - 1) {
+    cycles >>= 1;
+    b++;
+  }
+  return b;
+}
+
+void cec17_profile_enable(int active) {
+  if (active && !cec17_profile_active) {
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+    start_cycles = cec17_cycles();
+  }
+  cec17_profile_active = active != 0;
+}
+
+void cec17_profile_reset(void) {
+  int f, d, b;
+
+  for (f = 0; f < MAX_FUNCS; f++) {
+    for (d = 0; d < NUM_DIMS; d++) {
+      atomic_store(&slots[f][d].calls, 0);
+      atomic_store(&slots[f][d].evaluations, 0);
+      atomic_store(&slots[f][d].cycles, 0);
+      atomic_store(&slots[f][d].max_cycles, 0);
+      for (b = 0; b < CEC17_PROFILE_BUCKETS; b++) {
+        atomic_store(&slots[f][d].histogram[b], 0);
+      }
+    }
+  }
+}
+
+void cec17_profile_record(int func_num, int nx, uint64_t cycles, int mx) {
+  int d = dimension_index(nx);
+  struct profile_slot *slot;
+  uint64_t each, max;
+
+  if (func_num < 1 || func_num > MAX_FUNCS || d < 0 || mx <= 0) {
+    return;
+  }
+  slot = &slots[func_num - 1][d];
+  each = cycles / mx;
+
+  atomic_fetch_add_explicit(&slot->calls, 1, memory_order_relaxed);
+  atomic_fetch_add_explicit(&slot->evaluations, mx, memory_order_relaxed);
+  atomic_fetch_add_explicit(&slot->cycles, cycles, memory_order_relaxed);
+  atomic_fetch_add_explicit(&slot->histogram[bucket(each)], mx,
+                            memory_order_relaxed);
+  max = atomic_load_explicit(&slot->max_cycles, memory_order_relaxed);
+  while (each > max && !atomic_compare_exchange_weak(&slot->max_cycles, &max,
+                                                     each)) {
+  }
+}
+
+int cec17_profile_get(int func_num, int nx, cec17_profile_stats *stats) {
+  int d = dimension_index(nx), b;
+  struct profile_slot *slot;
+
+  memset(stats, 0, sizeof(*stats));
+  if (func_num < 1 || func_num > MAX_FUNCS || d < 0) {
+    return 0;
+  }
+  slot = &slots[func_num - 1][d];
+  stats->calls = atomic_load(&slot->calls);
+  stats->evaluations = atomic_load(&slot->evaluations);
+  stats->cycles = atomic_load(&slot->cycles);
+  stats->max_cycles = atomic_load(&slot->max_cycles);
+  for (b = 0; b < CEC17_PROFILE_BUCKETS; b++) {
+    stats->histogram[b] = atomic_load(&slot->histogram[b]);
+  }
+  return stats->evaluations > 0;
+}
+
+double cec17_profile_cycles_per_ns(void) {
+  struct timespec now;
+  uint64_t cycles = cec17_cycles();
+  double ns;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  ns = (now.tv_sec - start_time.tv_sec) * 1e9 +
+       (now.tv_nsec - start_time.tv_nsec);
+  return ns > 0.0 ? (cycles - start_cycles) / ns : 1.0;
+}
+
+/* Upper bound of the bucket holding the given fraction of evaluations */
+static uint64_t percentile(const cec17_profile_stats *stats, double fraction) {
+  uint64_t target = (uint64_t)(fraction * stats->evaluations), seen = 0;
+  int b;
+
+  for (b = 0; b < CEC17_PROFILE_BUCKETS - 1; b++) {
+    seen += stats->histogram[b];
+    if (seen > target) {
+      break;
+    }
+  }
+  return ((uint64_t)2 << b) - 1;
+}
+
+void cec17_profile_print(FILE *out) {
+  cec17_profile_stats stats;
+  double per_ns = cec17_profile_cycles_per_ns();
+  int f, d;
+
+  fprintf(out, "funcid,dim,evaluations,calls,cycles/eval,ns/eval,p50,p90,p99,"
+               "max\n");
+  for (f = 1; f <= MAX_FUNCS; f++) {
+    for (d = 0; d < NUM_DIMS; d++) {
+      if (!cec17_profile_get(f, dimensions[d], &stats)) {
+        continue;
+      }
+      fprintf(out, "%d,%d,%llu,%llu,%.0f,%.1f,%llu,%llu,%llu,%llu\n", f,
+              dimensions[d], (unsigned long long)stats.evaluations,
+              (unsigned long long)stats.calls,
+              (double)stats.cycles / stats.evaluations,
+              (double)stats.cycles / stats.evaluations / per_ns,
+              (unsigned long long)percentile(&stats, 0.5),
+              (unsigned long long)percentile(&stats, 0.9),
+              (unsigned long long)percentile(&stats, 0.99),
+              (unsigned long long)stats.max_cycles);
+    }
+  }
+}
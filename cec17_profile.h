@@ -0,0 +1,85 @@
+#ifndef _CEC17_PROFILE
+
+#define _CEC17_PROFILE 1
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+/**
+ * Perfilado de las evaluaciones: cuando está activo, cada llamada a
+ * cec17_context_evaluate (y por tanto a cec17_test_func y cec17_fitness)
+ * mide sus ciclos y los acumula, por función y dimensión, en un histograma
+ * del coste por evaluación. Desactivado (por defecto) solo cuesta comprobar
+ * cec17_profile_active en cada llamada.
+ */
+
+/**
+ * Intervalos del histograma: el intervalo b cuenta las evaluaciones de entre
+ * 2^b y 2^(b+1) - 1 ciclos.
+ */
+#define CEC17_PROFILE_BUCKETS 40
+
+typedef struct {
+  uint64_t calls;       /* llamadas (lotes) medidas */
+  uint64_t evaluations; /* soluciones evaluadas */
+  uint64_t cycles;      /* ciclos de todas las llamadas */
+  uint64_t max_cycles;  /* máximo de ciclos por evaluación */
+  uint64_t histogram[CEC17_PROFILE_BUCKETS];
+} cec17_profile_stats;
+
+/**
+ * Indica si el perfilado está activo (no debe cambiarse directamente).
+ */
+extern int cec17_profile_active;
+
+/**
+ * Contador de ciclos del procesador (o nanosegundos si no lo hay).
+ */
+static inline uint64_t cec17_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+  return __builtin_ia32_rdtsc();
+#else
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+#endif
+}
+
+/**
+ * Activa o desactiva el perfilado. Al activarlo se empieza a calibrar la
+ * relación entre ciclos y nanosegundos.
+ */
+void cec17_profile_enable(int active);
+
+/**
+ * Borra todas las medidas.
+ */
+void cec17_profile_reset(void);
+
+/**
+ * Acumula una llamada que ha evaluado mx soluciones en cycles ciclos.
+ */
+void cec17_profile_record(int func_num, int nx, uint64_t cycles, int mx);
+
+/**
+ * Copia las medidas de una función y dimensión.
+ * @return 1 si hay alguna evaluación medida, 0 si no.
+ */
+int cec17_profile_get(int func_num, int nx, cec17_profile_stats *stats);
+
+/**
+ * Ciclos por nanosegundo medidos desde que se activó el perfilado.
+ */
+double cec17_profile_cycles_per_ns(void);
+
+/**
+ * Escribe un resumen de las medidas en CSV: por función y dimensión,
+ * evaluaciones, llamadas, ciclos y nanosegundos medios por evaluación,
+ * percentiles 50, 90 y 99 (cota superior de su intervalo del histograma) y
+ * máximo, en ciclos.
+ */
+void cec17_profile_print(FILE *out);
+
+#endif
@@ -0,0 +1,264 @@
+#include "cec17_simd.h"
+#include <math.h>
+#include <string.h>
+
+/*
+ * The kernels are written with GCC vector extensions, so each operation on a
+ * vdouble works on SIMD_WIDTH lanes at once: the compiler emits one AVX-512
+ * instruction, two AVX2 ones or four SSE2 ones for it. target_clones builds
+ * the three versions of every exported kernel and picks one at load time.
+ */
+#define SIMD_WIDTH 8
+#define SIMD_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+/* Vectors are passed in registers only within a clone, so the helpers must
+   always be inlined into it */
+#define SIMD_INLINE static inline __attribute__((always_inline))
+
+typedef double vdouble __attribute__((vector_size(8 * SIMD_WIDTH)));
+typedef long long vlong __attribute__((vector_size(8 * SIMD_WIDTH)));
+
+#define PI 3.1415926535897932384626433832795029
+
+/* Largest argument reduced by the polynomial sine and cosine */
+#define TRIG_MAX 1.0e5
+
+/* pi/2 split in three parts, the first two with 33 significant bits so that
+   q * part is exact for |q| < 2^20, and the rest of pi/2 (fdlibm) */
+static const double two_over_pi = 6.36619772367581382433e-01;
+static const double pio2_1 = 1.57079632673412561417e+00;
+static const double pio2_2 = 6.07710050630396597660e-11;
+static const double pio2_2t = 2.02226624879595063154e-21;
+
+/* Minimax coefficients on [-pi/4, pi/4] (fdlibm __kernel_sin/__kernel_cos) */
+static const double S1 = -1.66666666666666324348e-01;
+static const double S2 = 8.33333333332248946124e-03;
+static const double S3 = -1.98412698298579493134e-04;
+static const double S4 = 2.75573137070700676789e-06;
+static const double S5 = -2.50507602534068634195e-08;
+static const double S6 = 1.58969099521155010221e-10;
+static const double C1 = 4.16666666666666019037e-02;
+static const double C2 = -1.38888888888741095749e-03;
+static const double C3 = 2.48015872894767294178e-05;
+static const double C4 = -2.75573143513906633035e-07;
+static const double C5 = 2.08757232129817482790e-09;
+static const double C6 = -1.13596475577881948265e-11;
+
+SIMD_INLINE vdouble vselect(vlong mask, vdouble a, vdouble b) {
+  return (vdouble)((mask & (vlong)a) | (~mask & (vlong)b));
+}
+
+SIMD_INLINE vdouble vabs(vdouble x) {
+  return (vdouble)((vlong)x & 0x7fffffffffffffffLL);
+}
+
+/* Mask of the first n lanes */
+SIMD_INLINE vlong vfirst(int n) {
+  const vlong lane = {0, 1, 2, 3, 4, 5, 6, 7};
+  return lane < n;
+}
+
+/* Loads n <= SIMD_WIDTH values, the remaining lanes are zero */
+SIMD_INLINE vdouble vload(const double *p, int n) {
+  vdouble v = {0};
+  memcpy(&v, p, n * sizeof(double));
+  return v;
+}
+
+SIMD_INLINE double vsum(vdouble v) {
+  double sum = 0.0;
+  int k;
+
+  for (k = 0; k < SIMD_WIDTH; k++) {
+    sum += v[k];
+  }
+  return sum;
+}
+
+SIMD_INLINE vdouble vsqrt(vdouble x) {
+  int k;
+
+  for (k = 0; k < SIMD_WIDTH; k++) {
+    x[k] = sqrt(x[k]);
+  }
+  return x;
+}
+
+/*
+ * Sine (cosine if cosine != 0) of every lane: the argument is reduced to
+ * r in [-pi/4, pi/4] and quadrant q, and the polynomial of sin(r) or cos(r)
+ * is chosen by q. Lanes with |x| > TRIG_MAX (or not finite) use the libm.
+ */
+SIMD_INLINE vdouble vsincos(vdouble x, int cosine) {
+  vdouble q, r, z, hz, w, s, c, v;
+  vlong qi, swap, negate, big;
+  int k;
+
+  /* Round to nearest with the 1.5 * 2^52 trick, valid while |q| < 2^51 */
+  q = x * two_over_pi;
+  q = (q + 0x1.8p52) - 0x1.8p52;
+  qi = __builtin_convertvector(q, vlong) + cosine;
+
+  r = x - q * pio2_1;
+  r = r - q * pio2_2;
+  r = r - q * pio2_2t;
+
+  z = r * r;
+  v = z * r;
+  s = r + v * (S1 + z * (S2 + z * (S3 + z * (S4 + z * (S5 + z * S6)))));
+
+  hz = 0.5 * z;
+  w = 1.0 - hz;
+  c = w + (((1.0 - w) - hz) +
+           z * z * (C1 + z * (C2 + z * (C3 + z * (C4 + z * (C5 + z * C6))))));
+
+  /* cos(x) = sin(x + pi/2), so the cosine moves one quadrant forward */
+  swap = (qi & 1) != 0;
+  negate = (qi & 2) != 0;
+  v = vselect(swap, c, s);
+  v = vselect(negate, -v, v);
+
+  big = ~(vabs(x) <= TRIG_MAX);
+  for (k = 0; k < SIMD_WIDTH; k++) {
+    if (big[k]) {
+      v[k] = cosine ? cos(x[k]) : sin(x[k]);
+    }
+  }
+  return v;
+}
+
+SIMD_INLINE vdouble vcos(vdouble x) { return vsincos(x, 1); }
+
+SIMD_INLINE vdouble vsin(vdouble x) { return vsincos(x, 0); }
+
+SIMD_CLONES double cec17_simd_rastrigin(const double *z, int nx) {
+  vdouble acc = {0}, v;
+  int i, n;
+
+  for (i = 0; i < nx; i += SIMD_WIDTH) {
+    n = nx - i < SIMD_WIDTH ? nx - i : SIMD_WIDTH;
+    v = vload(&z[i], n);
+    v = v * v - 10.0 * vcos(2.0 * PI * v) + 10.0;
+    acc += vselect(vfirst(n), v, acc - acc);
+  }
+  return vsum(acc);
+}
+
+SIMD_CLONES double cec17_simd_cos_sum(const double *z, int nx) {
+  vdouble acc = {0}, v;
+  int i, n;
+
+  for (i = 0; i < nx; i += SIMD_WIDTH) {
+    n = nx - i < SIMD_WIDTH ? nx - i : SIMD_WIDTH;
+    v = vcos(2.0 * PI * vload(&z[i], n));
+    acc += vselect(vfirst(n), v, acc - acc);
+  }
+  return vsum(acc);
+}
+
+SIMD_CLONES void cec17_simd_ackley(const double *z, int nx, double *sum1,
+                                   double *sum2) {
+  vdouble acc1 = {0}, acc2 = {0}, v;
+  int i, n;
+
+  for (i = 0; i < nx; i += SIMD_WIDTH) {
+    n = nx - i < SIMD_WIDTH ? nx - i : SIMD_WIDTH;
+    v = vload(&z[i], n);
+    acc1 += v * v;
+    acc2 += vselect(vfirst(n), vcos(2.0 * PI * v), acc2 - acc2);
+  }
+  *sum1 = vsum(acc1);
+  *sum2 = vsum(acc2);
+}
+
+SIMD_CLONES void cec17_simd_griewank(const double *z, int nx, double *s,
+                                     double *p) {
+  const vdouble lane = {0, 1, 2, 3, 4, 5, 6, 7};
+  vdouble acc = {0}, prod = acc + 1.0, v;
+  double product = 1.0;
+  int i, k, n;
+
+  for (i = 0; i < nx; i += SIMD_WIDTH) {
+    n = nx - i < SIMD_WIDTH ? nx - i : SIMD_WIDTH;
+    v = vload(&z[i], n);
+    acc += v * v;
+    /* The zero lanes of the last block give cos(0) = 1 */
+    prod *= vcos(v / vsqrt(lane + (i + 1.0)));
+  }
+  for (k = 0; k < SIMD_WIDTH; k++) {
+    product *= prod[k];
+  }
+  *s = vsum(acc);
+  *p = product;
+}
+
+SIMD_CLONES double cec17_simd_schwefel(const double *z, int nx) {
+  vdouble acc = {0}, v, t;
+  vlong inside;
+  double sum, tmp, zk;
+  int i, k, n;
+
+  sum = 0.0;
+  for (i = 0; i < nx; i += SIMD_WIDTH) {
+    n = nx - i < SIMD_WIDTH ? nx - i : SIMD_WIDTH;
+    v = vload(&z[i], n) + 4.209687462275036e+002;
+    inside = vfirst(n) & (v <= 500.0) & (v >= -500.0);
+    t = -v * vsin(vsqrt(vabs(v)));
+    acc += vselect(inside, t, acc - acc);
+
+    /* Genes out of [-500, 500] are rare, they follow the scalar code */
+    for (k = 0; k < n; k++) {
+      zk = v[k];
+      if (zk > 500) {
+        sum -= (500.0 - fmod(zk, 500)) * sin(pow(500.0 - fmod(zk, 500), 0.5));
+        tmp = (zk - 500.0) / 100;
+        sum += tmp * tmp / nx;
+      } else if (zk < -500) {
+        sum -= (-500.0 + fmod(fabs(zk), 500)) *
+               sin(pow(500.0 - fmod(fabs(zk), 500), 0.5));
+        tmp = (zk + 500.0) / 100;
+        sum += tmp * tmp / nx;
+      }
+    }
+  }
+  return vsum(acc) + sum;
+}
+
+SIMD_CLONES double cec17_simd_grie_rosen(const double *z, int nx) {
+  vdouble acc = {0}, a, b, tmp1, tmp2, temp;
+  int i, k, n;
+
+  for (i = 0; i < nx; i += SIMD_WIDTH) {
+    n = nx - i < SIMD_WIDTH ? nx - i : SIMD_WIDTH;
+    /* Every gene with the next one, the last with the first */
+    for (k = 0; k < SIMD_WIDTH; k++) {
+      a[k] = k < n ? z[i + k] + 1.0 : 0.0;
+      b[k] = k < n ? z[(i + k + 1) % nx] + 1.0 : 0.0;
+    }
+    tmp1 = a * a - b;
+    tmp2 = a - 1.0;
+    temp = 100.0 * tmp1 * tmp1 + tmp2 * tmp2;
+    temp = (temp * temp) / 4000.0 - vcos(temp) + 1.0;
+    acc += vselect(vfirst(n), temp, acc - acc);
+  }
+  return vsum(acc);
+}
+
+SIMD_CLONES double cec17_simd_escaffer6(const double *z, int nx) {
+  vdouble acc = {0}, a, b, s, temp1, temp2;
+  int i, k, n;
+
+  for (i = 0; i < nx; i += SIMD_WIDTH) {
+    n = nx - i < SIMD_WIDTH ? nx - i : SIMD_WIDTH;
+    for (k = 0; k < SIMD_WIDTH; k++) {
+      a[k] = k < n ? z[i + k] : 0.0;
+      b[k] = k < n ? z[(i + k + 1) % nx] : 0.0;
+    }
+    s = a * a + b * b;
+    temp1 = vsin(vsqrt(s));
+    temp1 = temp1 * temp1;
+    temp2 = 1.0 + 0.001 * s;
+    temp1 = 0.5 + (temp1 - 0.5) / (temp2 * temp2);
+    acc += vselect(vfirst(n), temp1, acc - acc);
+  }
+  return vsum(acc);
+}
@@ -0,0 +1,54 @@
+#ifndef _CEC17_SIMD
+
+#define _CEC17_SIMD 1
+
+/**
+ * Versiones vectoriales de los bucles por gen de las funciones básicas con
+ * más funciones trascendentes. Reciben el vector z ya desplazado y rotado y
+ * devuelven lo mismo que el bucle escalar al que sustituyen.
+ *
+ * Los resultados no son idénticos bit a bit a los escalares: los senos y
+ * cosenos se calculan con polinomios propios (error máximo respecto a la libm
+ * de 1 ulp para |x| <= 1e3 y de 2 ulp para |x| <= 1e5, por encima se usa la
+ * libm) y las sumas se acumulan en un orden distinto.
+ *
+ * Se compilan solo con la opción CEC17_SIMD, y cada función se genera para
+ * AVX-512, AVX2 y SSE2 eligiendo la adecuada al procesador en ejecución.
+ */
+
+/**
+ * Suma de z[i]^2 - 10 cos(2 PI z[i]) + 10 (Rastrigin y step Rastrigin).
+ */
+double cec17_simd_rastrigin(const double *z, int nx);
+
+/**
+ * Suma de cos(2 PI z[i]) (Lunacek bi-Rastrigin).
+ */
+double cec17_simd_cos_sum(const double *z, int nx);
+
+/**
+ * Suma de z[i]^2 en sum1 y de cos(2 PI z[i]) en sum2 (Ackley).
+ */
+void cec17_simd_ackley(const double *z, int nx, double *sum1, double *sum2);
+
+/**
+ * Suma de z[i]^2 en s y producto de cos(z[i] / sqrt(i + 1)) en p (Griewank).
+ */
+void cec17_simd_griewank(const double *z, int nx, double *s, double *p);
+
+/**
+ * Suma de los términos de cada gen de Schwefel (sin la constante final).
+ */
+double cec17_simd_schwefel(const double *z, int nx);
+
+/**
+ * Suma de los términos de cada par de genes de Griewank-Rosenbrock.
+ */
+double cec17_simd_grie_rosen(const double *z, int nx);
+
+/**
+ * Suma de los términos de cada par de genes de Expanded Schaffer F6.
+ */
+double cec17_simd_escaffer6(const double *z, int nx);
+
+#endif
@@ -8,342 +8,832 @@
 #include <stdlib.h>
 #include <math.h>
 #include <malloc.h>
+#include <pthread.h>
+#include "cec17_test_func.h"
+#include "cec17_archive.h"
+#include "cec17_fixed.h"
+#include "cec17_profile.h"
+#ifdef CEC17_OPENMP
+#include <omp.h>
+#endif
+#ifdef CEC17_SIMD
+#include "cec17_simd.h"
+#define SUPPORTED_FLAGS (CEC17_FLAG_SIMD|CEC17_FLAG_FIXED)
+#else
+#define SUPPORTED_FLAGS CEC17_FLAG_FIXED
+#endif
 
 #define INF 1.0e99
 #define EPS 1.0e-14
 #define E  2.7182818284590452353602874713526625
 #define PI 3.1415926535897932384626433832795029
 
-void sphere_func (double *, double *, int , double *,double *, int, int); /* Sphere */
-void ellips_func(double *, double *, int , double *,double *, int, int); /* Ellipsoidal */
-void bent_cigar_func(double *, double *, int , double *,double *, int, int); /* Discus */
-void discus_func(double *, double *, int , double *,double *, int, int);  /* Bent_Cigar */
-void dif_powers_func(double *, double *, int , double *,double *, int, int);  /* Different Powers */
-void rosenbrock_func (double *, double *, int , double *,double *, int, int); /* Rosenbrock's */
-void schaffer_F7_func (double *, double *, int , double *,double *, int, int); /* Schwefel's F7 */
-void ackley_func (double *, double *, int , double *,double *, int, int); /* Ackley's */
-void rastrigin_func (double *, double *, int , double *,double *, int, int); /* Rastrigin's  */
-void weierstrass_func (double *, double *, int , double *,double *, int, int); /* Weierstrass's  */
-void griewank_func (double *, double *, int , double *,double *, int, int); /* Griewank's  */
-void schwefel_func (double *, double *, int , double *,double *, int, int); /* Schwefel's */
-void katsuura_func (double *, double *, int , double *,double *, int, int); /* Katsuura */
-void bi_rastrigin_func (double *, double *, int , double *,double *, int, int); /* Lunacek Bi_rastrigin */
-void grie_rosen_func (double *, double *, int , double *,double *, int, int); /* Griewank-Rosenbrock  */
-void escaffer6_func (double *, double *, int , double *,double *, int, int); /* Expanded Scaffer¡¯s F6  */
-void step_rastrigin_func (double *, double *, int , double *,double *, int, int); /* Noncontinuous Rastrigin's  */
-void happycat_func (double *, double *, int , double *,double *, int, int); /* HappyCat */
-void hgbat_func (double *, double *, int , double *,double *, int, int); /* HGBat  */
+/* Solutions shifted and rotated together by sr_block */
+#define SR_BLOCK CEC17_BLOCK
+/* Components of the composition functions */
+#define CF_NUM 10
+
+typedef struct cec17_work
+{
+	double *y,*z;
+	double *tmp; /* nx values for levy and bi_rastrigin */
+	double *w; /* CF_NUM weights for cf_cal */
+	double *block; /* y and z rows of a block, then its y values transposed */
+	const double *pre_y,*pre_z; /* already done by sr_block for the next sr_func */
+	double *cf_y,*cf_z; /* y and z rows of a block for every component of a composition */
+	double *cf_dist; /* squared distances of a block to the optimum of every component */
+	int cf_row; /* row of the block in cf_y, cf_z and cf_dist being evaluated */
+	int flags; /* CEC17_FLAG_* */
+	int fixed_nx; /* dimension of the fixed kernels, 0 if there are none */
+	cec17_fixed_kernels fixed;
+} cec17_work;
+
+void sphere_func (cec17_work *, double *, double *, int , double *,double *, int, int); /* Sphere */
+void ellips_func(cec17_work *, double *, double *, int , double *,double *, int, int); /* Ellipsoidal */
+void bent_cigar_func(cec17_work *, double *, double *, int , double *,double *, int, int); /* Discus */
+void discus_func(cec17_work *, double *, double *, int , double *,double *, int, int);  /* Bent_Cigar */
+void dif_powers_func(cec17_work *, double *, double *, int , double *,double *, int, int);  /* Different Powers */
+void rosenbrock_func (cec17_work *, double *, double *, int , double *,double *, int, int); /* Rosenbrock's */
+void schaffer_F7_func (cec17_work *, double *, double *, int , double *,double *, int, int); /* Schwefel's F7 */
+void ackley_func (cec17_work *, double *, double *, int , double *,double *, int, int); /* Ackley's */
+void rastrigin_func (cec17_work *, double *, double *, int , double *,double *, int, int); /* Rastrigin's  */
+void weierstrass_func (cec17_work *, double *, double *, int , double *,double *, int, int); /* Weierstrass's  */
+void griewank_func (cec17_work *, double *, double *, int , double *,double *, int, int); /* Griewank's  */
+void schwefel_func (cec17_work *, double *, double *, int , double *,double *, int, int); /* Schwefel's */
+void katsuura_func (cec17_work *, double *, double *, int , double *,double *, int, int); /* Katsuura */
+void bi_rastrigin_func (cec17_work *, double *, double *, int , double *,double *, int, int); /* Lunacek Bi_rastrigin */
+void grie_rosen_func (cec17_work *, double *, double *, int , double *,double *, int, int); /* Griewank-Rosenbrock  */
+void escaffer6_func (cec17_work *, double *, double *, int , double *,double *, int, int); /* Expanded Scaffer¡¯s F6  */
+void step_rastrigin_func (cec17_work *, double *, double *, int , double *,double *, int, int); /* Noncontinuous Rastrigin's  */
+void happycat_func (cec17_work *, double *, double *, int , double *,double *, int, int); /* HappyCat */
+void hgbat_func (cec17_work *, double *, double *, int , double *,double *, int, int); /* HGBat  */
 
 /* New functions Noor Changes */
-void sum_diff_pow_func(double *, double *, int , double *,double *, int, int); /* Sum of different power */
-void zakharov_func(double *, double *, int , double *,double *, int, int); /* ZAKHAROV */
-void levy_func(double *, double *, int , double *,double *, int, int); /* Levy */
-void dixon_price_func(double *, double *, int , double *,double *, int, int); /* Dixon and Price */
-
-void hf01 (double *, double *, int, double *,double *, int *,int, int); /* Hybrid Function 1 */
-void hf02 (double *, double *, int, double *,double *, int *,int, int); /* Hybrid Function 2 */
-void hf03 (double *, double *, int, double *,double *, int *,int, int); /* Hybrid Function 3 */
-void hf04 (double *, double *, int, double *,double *, int *,int, int); /* Hybrid Function 4 */
-void hf05 (double *, double *, int, double *,double *, int *,int, int); /* Hybrid Function 5 */
-void hf06 (double *, double *, int, double *,double *, int *,int, int); /* Hybrid Function 6 */
-void hf07 (double *, double *, int, double *,double *, int *,int, int); /* Hybrid Function 7 */
-void hf08 (double *, double *, int, double *,double *, int *,int, int); /* Hybrid Function 8 */
-void hf09 (double *, double *, int, double *,double *, int *,int, int); /* Hybrid Function 9 */
-void hf10 (double *, double *, int, double *,double *, int *,int, int); /* Hybrid Function 10 */
-
-void cf01 (double *, double *, int , double *,double *, int); /* Composition Function 1 */
-void cf02 (double *, double *, int , double *,double *, int); /* Composition Function 2 */
-void cf03 (double *, double *, int , double *,double *, int); /* Composition Function 3 */
-void cf04 (double *, double *, int , double *,double *, int); /* Composition Function 4 */
-void cf05 (double *, double *, int , double *,double *, int); /* Composition Function 5 */
-void cf06 (double *, double *, int , double *,double *, int); /* Composition Function 6 */
-void cf07 (double *, double *, int , double *,double *, int); /* Composition Function 7 */
-void cf08 (double *, double *, int , double *,double *, int); /* Composition Function 8 */
-void cf09 (double *, double *, int , double *,double *, int *, int); /* Composition Function 9 */
-void cf10 (double *, double *, int , double *,double *, int *, int); /* Composition Function 10 */
+void sum_diff_pow_func(cec17_work *, double *, double *, int , double *,double *, int, int); /* Sum of different power */
+void zakharov_func(cec17_work *, double *, double *, int , double *,double *, int, int); /* ZAKHAROV */
+void levy_func(cec17_work *, double *, double *, int , double *,double *, int, int); /* Levy */
+void dixon_price_func(cec17_work *, double *, double *, int , double *,double *, int, int); /* Dixon and Price */
+
+void hf01 (cec17_work *, double *, double *, int, double *,double *, int *,int, int); /* Hybrid Function 1 */
+void hf02 (cec17_work *, double *, double *, int, double *,double *, int *,int, int); /* Hybrid Function 2 */
+void hf03 (cec17_work *, double *, double *, int, double *,double *, int *,int, int); /* Hybrid Function 3 */
+void hf04 (cec17_work *, double *, double *, int, double *,double *, int *,int, int); /* Hybrid Function 4 */
+void hf05 (cec17_work *, double *, double *, int, double *,double *, int *,int, int); /* Hybrid Function 5 */
+void hf06 (cec17_work *, double *, double *, int, double *,double *, int *,int, int); /* Hybrid Function 6 */
+void hf07 (cec17_work *, double *, double *, int, double *,double *, int *,int, int); /* Hybrid Function 7 */
+void hf08 (cec17_work *, double *, double *, int, double *,double *, int *,int, int); /* Hybrid Function 8 */
+void hf09 (cec17_work *, double *, double *, int, double *,double *, int *,int, int); /* Hybrid Function 9 */
+void hf10 (cec17_work *, double *, double *, int, double *,double *, int *,int, int); /* Hybrid Function 10 */
+
+void cf01 (cec17_work *, double *, double *, int , double *,double *, int); /* Composition Function 1 */
+void cf02 (cec17_work *, double *, double *, int , double *,double *, int); /* Composition Function 2 */
+void cf03 (cec17_work *, double *, double *, int , double *,double *, int); /* Composition Function 3 */
+void cf04 (cec17_work *, double *, double *, int , double *,double *, int); /* Composition Function 4 */
+void cf05 (cec17_work *, double *, double *, int , double *,double *, int); /* Composition Function 5 */
+void cf06 (cec17_work *, double *, double *, int , double *,double *, int); /* Composition Function 6 */
+void cf07 (cec17_work *, double *, double *, int , double *,double *, int); /* Composition Function 7 */
+void cf08 (cec17_work *, double *, double *, int , double *,double *, int); /* Composition Function 8 */
+void cf09 (cec17_work *, double *, double *, int , double *,double *, int *, int); /* Composition Function 9 */
+void cf10 (cec17_work *, double *, double *, int , double *,double *, int *, int); /* Composition Function 10 */
 
 void shiftfunc (double*,double*,int,double*);
 void rotatefunc (double*,double*,int, double*);
-void sr_func (double *, double *, int, double*, double*, double, int, int); /* shift and rotate */
+void sr_func (cec17_work *, double *, double *, int, double*, double*, double, int, int); /* shift and rotate */
+void sr_block (cec17_work *, double *, int, int, double *, double *, double); /* shift and rotate a block */
+void rotate_block (cec17_work *, double *, int, int, double *, double *); /* rotate a transposed block */
+void cf_block (cec17_work *, double *, int, int, double *, double *, const double *, int); /* shift and rotate a block for every component */
+void cf_pre (cec17_work *, int, int, int); /* use the shift and rotation of a component done by cf_block */
+void hf_sr_func (cec17_work *, double *, int, double*, double*, int *, int, int); /* shift, rotate and shuffle */
+void work_rotate (cec17_work *, double *, double *, int, double *); /* rotatefunc or its fixed version */
 void asyfunc (double *, double *x, int, double);
 void oszfunc (double *, double *, int);
-void cf_cal(double *, double *, int, double *,double *,double *,double *,int);
-
-double *OShift,*M,*y,*z,*x_bound;
-int ini_flag,n_flag,func_flag,*SS;
-
+void cf_cal(cec17_work *, double *, int, double *,double *,double *,int);
 
-void cec17_test_func(double *x, double *f, int nx, int mx,int func_num)
+typedef struct cec17_problem
 {
-	int cf_num=10,i,j;
-	if (ini_flag==1)
+	int func_num,nx;
+	double *OShift,*M;
+	int *SS;
+	int mapped; /* M, OShift and SS point into the packed archive */
+	int cached; /* owned by the problem cache */
+	int refs; /* contexts bound to the problem */
+	size_t bytes; /* heap memory held by the problem */
+	unsigned long last_use;
+} cec17_problem;
+
+struct cec17_context
+{
+	cec17_problem *problem;
+	size_t capacity; /* doubles in the scratch arena */
+	double *arena; /* every buffer used while evaluating */
+	unsigned long allocations; /* times the arena has been allocated */
+	double *x_bound;
+	cec17_work work;
+};
+
+/* Loaded problems, indexed by function and dimension */
+#define CACHE_FUNCS 30
+#define CACHE_DIMS 6
+static const int cache_dims[CACHE_DIMS]={2,10,20,30,50,100};
+static cec17_problem *cache[CACHE_FUNCS][CACHE_DIMS];
+static size_t cache_budget=0,cache_usage=0;
+static unsigned long cache_tick=0;
+static pthread_mutex_t cache_lock=PTHREAD_MUTEX_INITIALIZER;
+
+static cec17_context *default_ctx;
+
+/* Parallel batches of cec17_test_func: chunk t of a batch is evaluated on
+   parallel_ctx[t], so every thread has its own scratch */
+#define PARALLEL_MAX_THREADS 256
+#define PARALLEL_GRAIN 32
+static int parallel_threads=1;
+static int parallel_grain=PARALLEL_GRAIN;
+#ifdef CEC17_OPENMP
+static cec17_context *parallel_ctx[PARALLEL_MAX_THREADS];
+#endif
+
+/* Coefficients that do not depend on x, built once by coef_init. The
+   ellipsoid and different powers tables hold every dimension n up to
+   COEF_DIMS (hybrid functions call them with parts of x) starting at
+   n*(n-1)/2 */
+#define COEF_DIMS 100
+#define WEIERSTRASS_K 20
+#define KATSUURA_J 32
+static double ellips_coef[COEF_DIMS*(COEF_DIMS+1)/2];
+static double dif_powers_coef[COEF_DIMS*(COEF_DIMS+1)/2];
+static double weierstrass_a[WEIERSTRASS_K+1],weierstrass_b[WEIERSTRASS_K+1],weierstrass_sum2;
+static double katsuura_pow[KATSUURA_J+1];
+static pthread_once_t coef_once=PTHREAD_ONCE_INIT;
+
+static void coef_init(void)
+{
+	int i,j,nx;
+	double a=0.5,b=3.0;
+	for (nx=1; nx<=COEF_DIMS; nx++)
 	{
-		if ((n_flag!=nx)||(func_flag!=func_num))
+		for (i=0; i<nx; i++)
 		{
-			ini_flag=0;
+			ellips_coef[nx*(nx-1)/2+i]=pow(10.0,6.0*i/(nx-1));
+			if (nx>1)
+				dif_powers_coef[nx*(nx-1)/2+i]=2+4*i/(nx-1);
 		}
 	}
+	weierstrass_sum2=0.0;
+	for (j=0; j<=WEIERSTRASS_K; j++)
+	{
+		weierstrass_a[j]=pow(a,j);
+		weierstrass_b[j]=2.0*PI*pow(b,j);
+		weierstrass_sum2 += weierstrass_a[j]*cos(weierstrass_b[j]*0.5);
+	}
+	for (j=1; j<=KATSUURA_J; j++)
+		katsuura_pow[j]=pow(2.0,j);
+}
 
-	if (ini_flag==0)
+/* Reorder the rows of each of the num rotation matrices with its shuffle, so
+   that rotating gives the genes already shuffled */
+static int fold_shuffle(double *M, const int *SS, int nx, int num)
+{
+	int c,i,j;
+	double *row_data=(double *)malloc(sizeof(double)  *  nx  *  nx);
+	if (row_data==NULL)
 	{
-		FILE *fpt;
-		char FileName[256];
-		free(M);
-		free(OShift);
-		free(y);
-		free(z);
-		free(x_bound);
-		y=(double *)malloc(sizeof(double)  *  nx);
-		z=(double *)malloc(sizeof(double)  *  nx);
-		x_bound=(double *)malloc(sizeof(double)  *  nx);
+		printf("\nError: there is insufficient memory available!\n");
+		return 0;
+	}
+	for (c=0; c<num; c++)
+	{
+		double *Mc=&M[c*nx*nx];
+		const int *S=&SS[c*nx];
+		for (i=0; i<nx*nx; i++)
+			row_data[i]=Mc[i];
 		for (i=0; i<nx; i++)
-			x_bound[i]=100.0;
+			for (j=0; j<nx; j++)
+				Mc[i*nx+j]=row_data[(S[i]-1)*nx+j];
+	}
+	free(row_data);
+	return 1;
+}
+
+int cec17_load_text(int func_num, int nx, double **M, double **OShift, int **SS)
+{
+	int cf_num=10,i,j;
+	FILE *fpt;
+	char FileName[256];
 
-		if (!(nx==2||nx==10||nx==20||nx==30||nx==50||nx==100))
+	/* Load Matrix M*/
+	sprintf(FileName, "input_data/M_%d_D%d.txt", func_num,nx);
+	fpt = fopen(FileName,"r");
+	if (fpt==NULL)
+	{
+	    printf("\n Error: Cannot open input file for reading \n");
+		return 0;
+	}
+	if (func_num<20)
+	{
+		(*M)=(double*)calloc(nx*nx,sizeof(double));
+		if ((*M)==NULL)
+			printf("\nError: there is insufficient memory available!\n");
+		for (i=0; i<nx*nx; i++)
 		{
-			printf("\nError: Test functions are only defined for D=2,10,20,30,50,100.\n");
+			fscanf(fpt,"%lf",&(*M)[i]);
 		}
-		if (nx==2&&((func_num>=17&&func_num<=22)||(func_num>=29&&func_num<=30)))
+	}
+	else
+	{
+		(*M)=(double*)calloc(cf_num*nx*nx,sizeof(double));
+		if ((*M)==NULL)
+			printf("\nError: there is insufficient memory available!\n");
+		for (i=0; i<cf_num*nx*nx; i++)
 		{
-			printf("\nError: hf01,hf02,hf03,hf04,hf05,hf06,cf07&cf08 are NOT defined for D=2.\n");
+			fscanf(fpt,"%lf",&(*M)[i]);
 		}
+	}
+	fclose(fpt);
 
-		/* Load Matrix M*/
-		sprintf(FileName, "input_data/M_%d_D%d.txt", func_num,nx);
-		fpt = fopen(FileName,"r");
-		if (fpt==NULL)
+	/* Load shift_data */
+	sprintf(FileName, "input_data/shift_data_%d.txt", func_num);
+	fpt = fopen(FileName,"r");
+	if (fpt==NULL)
+	{
+		printf("\n Error: Cannot open input file for reading \n");
+		return 0;
+	}
+
+	if (func_num<20)
+	{
+		(*OShift)=(double *)calloc(nx,sizeof(double));
+		if ((*OShift)==NULL)
+		printf("\nError: there is insufficient memory available!\n");
+		for(i=0;i<nx;i++)
 		{
-		    printf("\n Error: Cannot open input file for reading \n");
+			fscanf(fpt,"%lf",&(*OShift)[i]);
 		}
-		if (func_num<20)
+	}
+	else
+	{
+		(*OShift)=(double *)calloc(nx*cf_num,sizeof(double));
+		if ((*OShift)==NULL)
+		printf("\nError: there is insufficient memory available!\n");
+		for(i=0;i<cf_num-1;i++)
 		{
-			M=(double*)malloc(nx*nx*sizeof(double));
-			if (M==NULL)
-				printf("\nError: there is insufficient memory available!\n");
-			for (i=0; i<nx*nx; i++)
+			for (j=0;j<nx;j++)
 			{
-				fscanf(fpt,"%lf",&M[i]);
+				fscanf(fpt,"%lf",&(*OShift)[i*nx+j]);
 			}
+			fscanf(fpt,"%*[^\n]%*c"); 
 		}
-		else
+		for (j=0;j<nx;j++)
 		{
-			M=(double*)malloc(cf_num*nx*nx*sizeof(double));
-			if (M==NULL)
-				printf("\nError: there is insufficient memory available!\n");
-			for (i=0; i<cf_num*nx*nx; i++)
-			{
-				fscanf(fpt,"%lf",&M[i]);
-			}
+			fscanf(fpt,"%lf",&(*OShift)[(cf_num-1)*nx+j]);
+		}
+			
+	}
+	fclose(fpt);
+
+
+	/* Load Shuffle_data */
+	
+	if (func_num>=11&&func_num<=20)
+	{
+		sprintf(FileName, "input_data/shuffle_data_%d_D%d.txt", func_num, nx);
+		fpt = fopen(FileName,"r");
+		if (fpt==NULL)
+		{
+			printf("\n Error: Cannot open input file for reading \n");
+			return 0;
 		}
+		(*SS)=(int *)malloc(nx*sizeof(int));
+		if ((*SS)==NULL)
+			printf("\nError: there is insufficient memory available!\n");
+		for(i=0;i<nx;i++)
+		{
+			fscanf(fpt,"%d",&(*SS)[i]);
+		}	
 		fclose(fpt);
-		
-		/* Load shift_data */
-		sprintf(FileName, "input_data/shift_data_%d.txt", func_num);
+	}
+	else if (func_num==29||func_num==30)
+	{
+		sprintf(FileName, "input_data/shuffle_data_%d_D%d.txt", func_num, nx);
 		fpt = fopen(FileName,"r");
 		if (fpt==NULL)
 		{
 			printf("\n Error: Cannot open input file for reading \n");
+			return 0;
 		}
+		(*SS)=(int *)malloc(nx*cf_num*sizeof(int));
+		if ((*SS)==NULL)
+			printf("\nError: there is insufficient memory available!\n");
+		for(i=0;i<nx*cf_num;i++)
+		{
+			fscanf(fpt,"%d",&(*SS)[i]);
+		}
+		fclose(fpt);
+	}
+
+	/* The hybrid functions (also the 3 in cf09 and cf10) expect it */
+	if (func_num>=11&&func_num<=20)
+		return fold_shuffle(*M,*SS,nx,1);
+	else if (func_num==29||func_num==30)
+		return fold_shuffle(*M,*SS,nx,3);
+	return 1;
+}
+
+void cec17_data_sizes(int func_num, int nx, long *m_size, long *shift_size, long *shuffle_size)
+{
+	int cf_num=10;
+	*m_size=(func_num<20)?nx*nx:cf_num*nx*nx;
+	*shift_size=(func_num<20)?nx:cf_num*nx;
+	if (func_num>=11&&func_num<=20)
+		*shuffle_size=nx;
+	else if (func_num==29||func_num==30)
+		*shuffle_size=cf_num*nx;
+	else
+		*shuffle_size=0;
+}
+
+static int load_problem(cec17_problem *prob)
+{
+	int nx=prob->nx,func_num=prob->func_num;
+	long m_size,shift_size,shuffle_size;
+	const void *M,*OShift,*SS=NULL;
+
+	if (!(nx==2||nx==10||nx==20||nx==30||nx==50||nx==100))
+	{
+		printf("\nError: Test functions are only defined for D=2,10,20,30,50,100.\n");
+	}
+	if (nx==2&&((func_num>=17&&func_num<=22)||(func_num>=29&&func_num<=30)))
+	{
+		printf("\nError: hf01,hf02,hf03,hf04,hf05,hf06,cf07&cf08 are NOT defined for D=2.\n");
+	}
+
+	/* Use the packed archive when it holds this problem */
+	cec17_data_sizes(func_num,nx,&m_size,&shift_size,&shuffle_size);
+	M=cec17_archive_find(func_num,nx,CEC17_ARCHIVE_M,m_size);
+	OShift=cec17_archive_find(func_num,nx,CEC17_ARCHIVE_SHIFT,shift_size);
+	if (shuffle_size>0)
+		SS=cec17_archive_find(func_num,nx,CEC17_ARCHIVE_SHUFFLE,shuffle_size);
+	if (M!=NULL&&OShift!=NULL&&(shuffle_size==0||SS!=NULL))
+	{
+		prob->M=(double *)M;
+		prob->OShift=(double *)OShift;
+		prob->SS=(int *)SS;
+		prob->mapped=1;
+		return 1;
+	}
+
+	prob->bytes=(m_size+shift_size)*sizeof(double)+shuffle_size*sizeof(int);
+	return cec17_load_text(func_num,nx,&prob->M,&prob->OShift,&prob->SS);
+}
+
+static void free_problem(cec17_problem *prob)
+{
+	if (!prob->mapped)
+	{
+		free(prob->M);
+		free(prob->OShift);
+		free(prob->SS);
+	}
+	free(prob);
+}
+
+static int cache_slot(int func_num, int nx)
+{
+	int d;
+	if (func_num<1||func_num>CACHE_FUNCS)
+		return -1;
+	for (d=0; d<CACHE_DIMS; d++)
+	{
+		if (cache_dims[d]==nx)
+			return d;
+	}
+	return -1;
+}
 
-		if (func_num<20)
+/* Drop the least recently used idle problems until the budget is met.
+   Must be called with cache_lock held. */
+static void cache_trim(size_t budget)
+{
+	int i,d;
+	cec17_problem *lru;
+	while (budget>0&&cache_usage>budget)
+	{
+		lru=NULL;
+		for (i=0; i<CACHE_FUNCS; i++)
 		{
-			OShift=(double *)malloc(nx*sizeof(double));
-			if (OShift==NULL)
-			printf("\nError: there is insufficient memory available!\n");
-			for(i=0;i<nx;i++)
+			for (d=0; d<CACHE_DIMS; d++)
 			{
-				fscanf(fpt,"%lf",&OShift[i]);
+				cec17_problem *prob=cache[i][d];
+				if (prob!=NULL&&prob->refs==0&&(lru==NULL||prob->last_use<lru->last_use))
+					lru=prob;
 			}
 		}
-		else
+		if (lru==NULL)
+			break;
+		cache[lru->func_num-1][cache_slot(lru->func_num,lru->nx)]=NULL;
+		cache_usage-=lru->bytes;
+		free_problem(lru);
+	}
+}
+
+static cec17_problem *acquire_problem(int func_num, int nx)
+{
+	cec17_problem *prob,*cached;
+	int d=cache_slot(func_num,nx);
+
+	if (d>=0)
+	{
+		pthread_mutex_lock(&cache_lock);
+		prob=cache[func_num-1][d];
+		if (prob!=NULL)
 		{
-			OShift=(double *)malloc(nx*cf_num*sizeof(double));
-			if (OShift==NULL)
-			printf("\nError: there is insufficient memory available!\n");
-			for(i=0;i<cf_num-1;i++)
-			{
-				for (j=0;j<nx;j++)
-				{
-					fscanf(fpt,"%lf",&OShift[i*nx+j]);
-				}
-				fscanf(fpt,"%*[^\n]%*c"); 
-			}
-			for (j=0;j<nx;j++)
-			{
-				fscanf(fpt,"%lf",&OShift[(cf_num-1)*nx+j]);
-			}
-				
+			prob->refs++;
+			prob->last_use=++cache_tick;
 		}
-		fclose(fpt);
+		pthread_mutex_unlock(&cache_lock);
+		if (prob!=NULL)
+			return prob;
+	}
 
+	/* Load outside the lock so other problems stay available meanwhile */
+	prob=(cec17_problem *)calloc(1,sizeof(cec17_problem));
+	if (prob==NULL)
+	{
+		printf("\nError: there is insufficient memory available!\n");
+		return NULL;
+	}
+	prob->func_num=func_num;
+	prob->nx=nx;
+	if (!load_problem(prob))
+	{
+		free_problem(prob);
+		return NULL;
+	}
+	prob->refs=1;
+	if (d<0)
+		return prob;
 
-		/* Load Shuffle_data */
-		
-		if (func_num>=11&&func_num<=20)
+	pthread_mutex_lock(&cache_lock);
+	cached=cache[func_num-1][d];
+	if (cached!=NULL)
+	{
+		/* Another thread loaded it first */
+		free_problem(prob);
+		prob=cached;
+		prob->refs++;
+	}
+	else
+	{
+		prob->cached=1;
+		cache[func_num-1][d]=prob;
+		cache_usage+=prob->bytes;
+	}
+	prob->last_use=++cache_tick;
+	cache_trim(cache_budget);
+	pthread_mutex_unlock(&cache_lock);
+	return prob;
+}
+
+static void release_problem(cec17_problem *prob)
+{
+	if (!prob->cached)
+	{
+		free_problem(prob);
+		return;
+	}
+	pthread_mutex_lock(&cache_lock);
+	prob->refs--;
+	cache_trim(cache_budget);
+	pthread_mutex_unlock(&cache_lock);
+}
+
+int cec17_cache_preload(int nx)
+{
+	int func_num,d,loaded=0;
+	for (d=0; d<CACHE_DIMS; d++)
+	{
+		if (nx!=0&&cache_dims[d]!=nx)
+			continue;
+		for (func_num=1; func_num<=CACHE_FUNCS; func_num++)
 		{
-			sprintf(FileName, "input_data/shuffle_data_%d_D%d.txt", func_num, nx);
-			fpt = fopen(FileName,"r");
-			if (fpt==NULL)
+			cec17_problem *prob;
+			if (cache_dims[d]==2&&((func_num>=17&&func_num<=22)||(func_num>=29&&func_num<=30)))
+				continue; /* not defined for D=2 */
+			if (!cec17_data_available(func_num,cache_dims[d]))
+				continue;
+			prob=acquire_problem(func_num,cache_dims[d]);
+			if (prob!=NULL)
 			{
-				printf("\n Error: Cannot open input file for reading \n");
+				release_problem(prob);
+				loaded++;
 			}
-			SS=(int *)malloc(nx*sizeof(int));
-			if (SS==NULL)
-				printf("\nError: there is insufficient memory available!\n");
-			for(i=0;i<nx;i++)
-			{
-				fscanf(fpt,"%d",&SS[i]);
-			}	
-			fclose(fpt);
 		}
-		else if (func_num==29||func_num==30)
+	}
+	return loaded;
+}
+
+void cec17_cache_set_budget(size_t bytes)
+{
+	pthread_mutex_lock(&cache_lock);
+	cache_budget=bytes;
+	cache_trim(cache_budget);
+	pthread_mutex_unlock(&cache_lock);
+}
+
+size_t cec17_cache_usage(void)
+{
+	size_t usage;
+	pthread_mutex_lock(&cache_lock);
+	usage=cache_usage;
+	pthread_mutex_unlock(&cache_lock);
+	return usage;
+}
+
+void cec17_cache_clear(void)
+{
+	pthread_mutex_lock(&cache_lock);
+	cache_trim(1);
+	pthread_mutex_unlock(&cache_lock);
+}
+
+/* Point the context to another problem, growing its scratch if needed */
+static int context_bind(cec17_context *ctx, int func_num, int nx)
+{
+	int i;
+	cec17_problem *prob;
+	/* y, z, tmp, x_bound, block and w, then cf_y, cf_z and cf_dist only for
+	   the compositions */
+	size_t size=(4+3*SR_BLOCK)*nx+CF_NUM;
+	size_t cf_size=func_num>=21?(2*nx+1)*CF_NUM*SR_BLOCK:0;
+
+	pthread_once(&coef_once,coef_init);
+	prob=acquire_problem(func_num,nx);
+	if (prob==NULL)
+		return 0;
+	if (size+cf_size>ctx->capacity)
+	{
+		double *arena=(double *)malloc(sizeof(double)  *  (size+cf_size));
+		if (arena==NULL)
 		{
-			sprintf(FileName, "input_data/shuffle_data_%d_D%d.txt", func_num, nx);
-			fpt = fopen(FileName,"r");
-			if (fpt==NULL)
-			{
-				printf("\n Error: Cannot open input file for reading \n");
-			}
-			SS=(int *)malloc(nx*cf_num*sizeof(int));
-			if (SS==NULL)
-				printf("\nError: there is insufficient memory available!\n");
-			for(i=0;i<nx*cf_num;i++)
-			{
-				fscanf(fpt,"%d",&SS[i]);
-			}
-			fclose(fpt);
+			printf("\nError: there is insufficient memory available!\n");
+			release_problem(prob);
+			return 0;
 		}
-		
+		free(ctx->arena);
+		ctx->arena=arena;
+		ctx->allocations++;
+		ctx->capacity=size+cf_size;
+	}
+	ctx->work.y=ctx->arena;
+	ctx->work.z=ctx->arena+nx;
+	ctx->work.tmp=ctx->arena+2*nx;
+	ctx->x_bound=ctx->arena+3*nx;
+	ctx->work.block=ctx->arena+4*nx;
+	ctx->work.w=ctx->arena+(4+3*SR_BLOCK)*nx;
+	ctx->work.cf_y=ctx->arena+size;
+	ctx->work.cf_z=ctx->work.cf_y+CF_NUM*SR_BLOCK*nx;
+	ctx->work.cf_dist=ctx->work.cf_z+CF_NUM*SR_BLOCK*nx;
+	ctx->work.fixed_nx=cec17_fixed_lookup(nx,&ctx->work.fixed)?nx:0;
+	for (i=0; i<nx; i++)
+		ctx->x_bound[i]=100.0;
 
-		n_flag=nx;
-		func_flag=func_num;
-		ini_flag=1;
-		//printf("Function has been initialized!\n");
+	if (ctx->problem!=NULL)
+		release_problem(ctx->problem);
+	ctx->problem=prob;
+	return 1;
+}
+
+cec17_context *cec17_context_create(int func_num, int nx)
+{
+	cec17_context *ctx;
+
+	ctx=(cec17_context *)calloc(1,sizeof(cec17_context));
+	if (ctx==NULL)
+	{
+		printf("\nError: there is insufficient memory available!\n");
+		return NULL;
+	}
+	ctx->work.flags=SUPPORTED_FLAGS;
+	if (!context_bind(ctx,func_num,nx))
+	{
+		cec17_context_destroy(ctx);
+		return NULL;
+	}
+	return ctx;
+}
+
+void cec17_context_destroy(cec17_context *ctx)
+{
+	if (ctx==NULL)
+		return;
+	if (ctx->problem!=NULL)
+		release_problem(ctx->problem);
+	free(ctx->arena);
+	free(ctx);
+}
+
+int cec17_context_funcid(const cec17_context *ctx)
+{
+	return ctx->problem->func_num;
+}
+
+int cec17_context_dimension(const cec17_context *ctx)
+{
+	return ctx->problem->nx;
+}
+
+unsigned long cec17_context_allocations(const cec17_context *ctx)
+{
+	return ctx->allocations;
+}
+
+int cec17_context_set_flags(cec17_context *ctx, int flags)
+{
+	ctx->work.flags=flags&SUPPORTED_FLAGS;
+	return ctx->work.flags;
+}
+
+/* Scaling of the outer shift and rotation of a function, or 0.0 if it
+   does not start with one (bi_rastrigin and the compositions) */
+static double sr_block_rate(int func_num)
+{
+	switch(func_num)
+	{
+	case 4:
+		return 2.048/100.0;
+	case 5:
+	case 8:
+		return 5.12/100.0;
+	case 10:
+		return 1000.0/100.0;
+	case 7:
+		return 0.0;
+	default:
+		return (func_num>=1&&func_num<=20)?1.0:0.0;
 	}
+}
 
+/* Components of each composition function (F21 to F30) and the scaling of
+   the shift and rotation of each one, the one of its basic function */
+static const int cf_components[10]={3,3,4,4,5,5,6,6,3,3};
+static const double cf_rates[10][CF_NUM]={
+	{2.048/100.0, 1.0, 5.12/100.0},
+	{5.12/100.0, 600.0/100.0, 1000.0/100.0},
+	{2.048/100.0, 1.0, 1000.0/100.0, 5.12/100.0},
+	{1.0, 1.0, 600.0/100.0, 5.12/100.0},
+	{5.12/100.0, 5.0/100.0, 1.0, 1.0, 2.048/100.0},
+	{1.0, 1000.0/100.0, 600.0/100.0, 2.048/100.0, 5.12/100.0},
+	{5.0/100.0, 5.12/100.0, 1000.0/100.0, 1.0, 1.0, 1.0},
+	{1.0, 600.0/100.0, 1.0, 2.048/100.0, 5.0/100.0, 1.0},
+	{1.0, 1.0, 1.0},
+	{1.0, 1.0, 1.0}
+};
+
+static void context_evaluate(cec17_context *ctx, double *x, double *f, int mx)
+{
+	int i,b,nx=ctx->problem->nx;
+	double *OShift=ctx->problem->OShift,*M=ctx->problem->M;
+	int *SS=ctx->problem->SS;
+	cec17_work *ws=&ctx->work;
+	int cf=ctx->problem->func_num-21;
+	double sh_rate=mx>1?sr_block_rate(ctx->problem->func_num):0.0;
 
 	for (i = 0; i < mx; i++)
 	{
-		switch(func_num)
+		b=i%SR_BLOCK;
+		if (sh_rate!=0.0)
+		{
+			if (b==0)
+				sr_block(ws,&x[i*nx],mx-i<SR_BLOCK?mx-i:SR_BLOCK,nx,OShift,M,sh_rate);
+			ws->pre_y=&ws->block[b*nx];
+			ws->pre_z=&ws->block[(SR_BLOCK+b)*nx];
+		}
+		else if (cf>=0&&cf<10)
+		{
+			/* Even for a single solution, the components share the pass */
+			if (b==0)
+				cf_block(ws,&x[i*nx],mx-i<SR_BLOCK?mx-i:SR_BLOCK,nx,OShift,M,cf_rates[cf],cf_components[cf]);
+			ws->cf_row=b;
+		}
+		switch(ctx->problem->func_num)
 		{
 		case 1:	
-			bent_cigar_func(&x[i*nx],&f[i],nx,OShift,M,1,1);
+			bent_cigar_func(ws,&x[i*nx],&f[i],nx,OShift,M,1,1);
 			f[i]+=100.0;
 			break;
 		case 2:	
-			sum_diff_pow_func(&x[i*nx],&f[i],nx,OShift,M,1,1);
+			sum_diff_pow_func(ws,&x[i*nx],&f[i],nx,OShift,M,1,1);
 			f[i]+=200.0;
 			break;
 		case 3:	
-			zakharov_func(&x[i*nx],&f[i],nx,OShift,M,1,1);
+			zakharov_func(ws,&x[i*nx],&f[i],nx,OShift,M,1,1);
 			f[i]+=300.0;
 			break;
 		case 4:	
-			rosenbrock_func(&x[i*nx],&f[i],nx,OShift,M,1,1);
+			rosenbrock_func(ws,&x[i*nx],&f[i],nx,OShift,M,1,1);
 			f[i]+=400.0;
 			break;
 		case 5:
-			rastrigin_func(&x[i*nx],&f[i],nx,OShift,M,1,1);
+			rastrigin_func(ws,&x[i*nx],&f[i],nx,OShift,M,1,1);
 			f[i]+=500.0;
 			break;
 		case 6:
-			schaffer_F7_func(&x[i*nx],&f[i],nx,OShift,M,1,1);
+			schaffer_F7_func(ws,&x[i*nx],&f[i],nx,OShift,M,1,1);
 			f[i]+=600.0;
 			break;
 		case 7:	
-			bi_rastrigin_func(&x[i*nx],&f[i],nx,OShift,M,1,1);
+			bi_rastrigin_func(ws,&x[i*nx],&f[i],nx,OShift,M,1,1);
 			f[i]+=700.0;
 			break;
 		case 8:	
-			step_rastrigin_func(&x[i*nx],&f[i],nx,OShift,M,1,1);
+			step_rastrigin_func(ws,&x[i*nx],&f[i],nx,OShift,M,1,1);
 			f[i]+=800.0;
 			break;
 		case 9:	
-			levy_func(&x[i*nx],&f[i],nx,OShift,M,1,1);
+			levy_func(ws,&x[i*nx],&f[i],nx,OShift,M,1,1);
 			f[i]+=900.0;
 			break;
 		case 10:	
-			schwefel_func(&x[i*nx],&f[i],nx,OShift,M,1,1);
+			schwefel_func(ws,&x[i*nx],&f[i],nx,OShift,M,1,1);
 			f[i]+=1000.0;
 			break;
 		case 11:	
-			hf01(&x[i*nx],&f[i],nx,OShift,M,SS,1,1);
+			hf01(ws,&x[i*nx],&f[i],nx,OShift,M,SS,1,1);
 			f[i]+=1100.0;
 			break;
 		case 12:	
-			hf02(&x[i*nx],&f[i],nx,OShift,M,SS,1,1);
+			hf02(ws,&x[i*nx],&f[i],nx,OShift,M,SS,1,1);
 			f[i]+=1200.0;
 			break;
 		case 13:	
-			hf03(&x[i*nx],&f[i],nx,OShift,M,SS,1,1);
+			hf03(ws,&x[i*nx],&f[i],nx,OShift,M,SS,1,1);
 			f[i]+=1300.0;
 			break;
 		case 14:	
-			hf04(&x[i*nx],&f[i],nx,OShift,M,SS,1,1);
+			hf04(ws,&x[i*nx],&f[i],nx,OShift,M,SS,1,1);
 			f[i]+=1400.0;
 			break;
 		case 15:	
-			hf05(&x[i*nx],&f[i],nx,OShift,M,SS,1,1);
+			hf05(ws,&x[i*nx],&f[i],nx,OShift,M,SS,1,1);
 			f[i]+=1500.0;
 			break;
 		case 16:	
-			hf06(&x[i*nx],&f[i],nx,OShift,M,SS,1,1);
+			hf06(ws,&x[i*nx],&f[i],nx,OShift,M,SS,1,1);
 			f[i]+=1600.0;
 			break;
 		case 17:	
-			hf07(&x[i*nx],&f[i],nx,OShift,M,SS,1,1);
+			hf07(ws,&x[i*nx],&f[i],nx,OShift,M,SS,1,1);
 			f[i]+=1700.0;
 			break;
 		case 18:	
-			hf08(&x[i*nx],&f[i],nx,OShift,M,SS,1,1);
+			hf08(ws,&x[i*nx],&f[i],nx,OShift,M,SS,1,1);
 			f[i]+=1800.0;
 			break;
 		case 19:	
-			hf09(&x[i*nx],&f[i],nx,OShift,M,SS,1,1);
+			hf09(ws,&x[i*nx],&f[i],nx,OShift,M,SS,1,1);
 			f[i]+=1900.0;
 			break;
 		case 20:	
-			hf10(&x[i*nx],&f[i],nx,OShift,M,SS,1,1);
+			hf10(ws,&x[i*nx],&f[i],nx,OShift,M,SS,1,1);
 			f[i]+=2000.0;
 			break;
 		case 21:	
-			cf01(&x[i*nx],&f[i],nx,OShift,M,1);
+			cf01(ws,&x[i*nx],&f[i],nx,OShift,M,1);
 			f[i]+=2100.0;
 			break;
 		case 22:	
-			cf02(&x[i*nx],&f[i],nx,OShift,M,1);
+			cf02(ws,&x[i*nx],&f[i],nx,OShift,M,1);
 			f[i]+=2200.0;
 			break;
 		case 23:	
-			cf03(&x[i*nx],&f[i],nx,OShift,M,1);
+			cf03(ws,&x[i*nx],&f[i],nx,OShift,M,1);
 			f[i]+=2300.0;
 			break;
 		case 24:	
-			cf04(&x[i*nx],&f[i],nx,OShift,M,1);
+			cf04(ws,&x[i*nx],&f[i],nx,OShift,M,1);
 			f[i]+=2400.0;
 			break;
 		case 25:	
-			cf05(&x[i*nx],&f[i],nx,OShift,M,1);
+			cf05(ws,&x[i*nx],&f[i],nx,OShift,M,1);
 			f[i]+=2500.0;
 			break;
 		case 26:
-			cf06(&x[i*nx],&f[i],nx,OShift,M,1);
+			cf06(ws,&x[i*nx],&f[i],nx,OShift,M,1);
 			f[i]+=2600.0;
 			break;
 		case 27:
-			cf07(&x[i*nx],&f[i],nx,OShift,M,1);
+			cf07(ws,&x[i*nx],&f[i],nx,OShift,M,1);
 			f[i]+=2700.0;
 			break;
 		case 28:
-			cf08(&x[i*nx],&f[i],nx,OShift,M,1);
+			cf08(ws,&x[i*nx],&f[i],nx,OShift,M,1);
 			f[i]+=2800.0;
 			break;
 		case 29:
-			cf09(&x[i*nx],&f[i],nx,OShift,M,SS,1);
+			cf09(ws,&x[i*nx],&f[i],nx,OShift,M,SS,1);
 			f[i]+=2900.0;
 			break;
 		case 30:
-			cf10(&x[i*nx],&f[i],nx,OShift,M,SS,1);
+			cf10(ws,&x[i*nx],&f[i],nx,OShift,M,SS,1);
 			f[i]+=3000.0;
 			break;
 		default:
@@ -353,14 +843,230 @@ void cec17_test_func(double *x, double *f, int nx, int mx,int func_num)
 		}
 		
 	}
+}
+
+void cec17_context_evaluate(cec17_context *ctx, double *x, double *f, int mx)
+{
+	uint64_t start;
+
+	if (!cec17_profile_active)
+	{
+		context_evaluate(ctx,x,f,mx);
+		return;
+	}
+	start=cec17_cycles();
+	context_evaluate(ctx,x,f,mx);
+	cec17_profile_record(ctx->problem->func_num,ctx->problem->nx,cec17_cycles()-start,mx);
+}
+
+int cec17_context_state_size(const cec17_context *ctx)
+{
+	return sr_block_rate(ctx->problem->func_num)!=0.0?2*ctx->problem->nx:0;
+}
+
+void cec17_context_evaluate_state(cec17_context *ctx, double *x, double *f, double *state)
+{
+	int i,nx=ctx->problem->nx;
+	double *OShift=ctx->problem->OShift,*M=ctx->problem->M;
+	double *y=state,*z=&state[nx];
+	double sh_rate=sr_block_rate(ctx->problem->func_num);
+
+	if (sh_rate==0.0)
+	{
+		cec17_context_evaluate(ctx,x,f,1);
+		return;
+	}
+	for (i=0; i<nx; i++)
+	{
+		y[i]=x[i]-OShift[i];
+		y[i]=y[i]*sh_rate;
+	}
+	work_rotate(&ctx->work,y,z,nx,M);
+	ctx->work.pre_y=y;
+	ctx->work.pre_z=z;
+	cec17_context_evaluate(ctx,x,f,1);
+}
+
+void cec17_context_evaluate_delta(cec17_context *ctx, double *x, double *f, double *state, const int *changed, int num_changed)
+{
+	int i,j,k,nx=ctx->problem->nx;
+	double *OShift=ctx->problem->OShift,*M=ctx->problem->M;
+	double *y=state,*z=&state[nx];
+	double sh_rate=sr_block_rate(ctx->problem->func_num),v,d;
+
+	if (sh_rate==0.0)
+	{
+		cec17_context_evaluate(ctx,x,f,1);
+		return;
+	}
+	/* z=M*y is linear, so each changed gene only adds its column of M */
+	for (j=0; j<num_changed; j++)
+	{
+		k=changed[j];
+		v=x[k]-OShift[k];
+		v=v*sh_rate;
+		d=v-y[k];
+		y[k]=v;
+		if (d==0.0)
+			continue;
+		for (i=0; i<nx; i++)
+		{
+			z[i]=z[i]+M[i*nx+k]*d;
+		}
+	}
+	ctx->work.pre_y=y;
+	ctx->work.pre_z=z;
+	cec17_context_evaluate(ctx,x,f,1);
+}
+
+/* Contexts of cec17_thread_context, destroyed when their thread ends */
+static pthread_key_t thread_ctx_key;
+static pthread_once_t thread_ctx_once=PTHREAD_ONCE_INIT;
+
+static void thread_ctx_free(void *ctx)
+{
+	cec17_context_destroy((cec17_context *)ctx);
+}
 
+static void thread_ctx_init(void)
+{
+	pthread_key_create(&thread_ctx_key,thread_ctx_free);
 }
 
-void sphere_func (double *x, double *f, int nx, double *Os, double *Mr, int s_flag, int r_flag) /* Sphere */
+cec17_context *cec17_thread_context(int func_num, int nx)
+{
+	cec17_context *ctx;
+
+	pthread_once(&thread_ctx_once,thread_ctx_init);
+	ctx=(cec17_context *)pthread_getspecific(thread_ctx_key);
+	if (ctx==NULL)
+	{
+		ctx=cec17_context_create(func_num,nx);
+		if (ctx!=NULL)
+			pthread_setspecific(thread_ctx_key,ctx);
+		return ctx;
+	}
+
+	if ((ctx->problem->nx!=nx)||(ctx->problem->func_num!=func_num))
+	{
+		if (!context_bind(ctx,func_num,nx))
+			return NULL;
+	}
+	return ctx;
+}
+
+cec17_context *cec17_default_context(int func_num, int nx)
+{
+	if (default_ctx==NULL)
+	{
+		default_ctx=(cec17_context *)calloc(1,sizeof(cec17_context));
+		if (default_ctx==NULL)
+		{
+			printf("\nError: there is insufficient memory available!\n");
+			return NULL;
+		}
+		default_ctx->work.flags=SUPPORTED_FLAGS;
+	}
+
+	if (default_ctx->problem==NULL||(default_ctx->problem->nx!=nx)||(default_ctx->problem->func_num!=func_num))
+	{
+		if (!context_bind(default_ctx,func_num,nx))
+			return NULL;
+		//printf("Function has been initialized!\n");
+	}
+	return default_ctx;
+}
+
+int cec17_set_threads(int threads)
+{
+#ifdef CEC17_OPENMP
+	if (threads<=0)
+		threads=omp_get_num_procs();
+	parallel_threads=threads<PARALLEL_MAX_THREADS?threads:PARALLEL_MAX_THREADS;
+#else
+	(void)threads;
+	parallel_threads=1;
+#endif
+	return parallel_threads;
+}
+
+void cec17_set_grain(int rows)
+{
+	parallel_grain=rows>0?rows:PARALLEL_GRAIN;
+}
+
+#ifdef CEC17_OPENMP
+/* Evaluates the batch in chunks, or returns 0 if it must stay serial */
+static int parallel_evaluate(cec17_context *ctx, double *x, double *f, int nx, int mx, int func_num)
+{
+	int t,chunks=mx/parallel_grain,rows;
+
+	if (chunks>parallel_threads)
+		chunks=parallel_threads;
+	if (chunks<2)
+		return 0;
+	/* Chunks of whole blocks, the last one takes the rest */
+	rows=((mx+chunks-1)/chunks+SR_BLOCK-1)/SR_BLOCK*SR_BLOCK;
+	chunks=(mx+rows-1)/rows;
+	if (chunks<2)
+		return 0;
+
+	/* Bound here, as the problem cache may have to load the data */
+	for (t=0; t<chunks; t++)
+	{
+		cec17_context *worker=parallel_ctx[t];
+		if (worker==NULL)
+		{
+			worker=(cec17_context *)calloc(1,sizeof(cec17_context));
+			if (worker==NULL)
+				return 0;
+			parallel_ctx[t]=worker;
+		}
+		if (worker->problem==NULL||worker->problem->nx!=nx||worker->problem->func_num!=func_num)
+		{
+			if (!context_bind(worker,func_num,nx))
+				return 0;
+		}
+		worker->work.flags=ctx->work.flags;
+	}
+
+	/* Each row only depends on itself, so the results do not depend on the
+	   number of threads */
+#pragma omp parallel for num_threads(chunks) schedule(static,1)
+	for (t=0; t<chunks; t++)
+	{
+		int first=t*rows;
+		cec17_context_evaluate(parallel_ctx[t],&x[first*nx],&f[first],mx-first<rows?mx-first:rows);
+	}
+	return 1;
+}
+#endif
+
+void cec17_test_func(double *x, double *f, int nx, int mx,int func_num)
 {
+	int i;
+	cec17_context *ctx=cec17_default_context(func_num,nx);
+
+	if (ctx==NULL)
+	{
+		for (i = 0; i < mx; i++)
+			f[i] = 0.0;
+		return;
+	}
+#ifdef CEC17_OPENMP
+	if (parallel_threads>1&&parallel_evaluate(ctx,x,f,nx,mx,func_num))
+		return;
+#endif
+	cec17_context_evaluate(ctx,x,f,mx);
+}
+
+
+void sphere_func (cec17_work *ws, double *x, double *f, int nx, double *Os, double *Mr, int s_flag, int r_flag) /* Sphere */
+{
+	double *z=ws->z;
 	int i;
 	f[0] = 0.0;
-	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */	
+	sr_func (ws, x, z, nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */	
 	for (i=0; i<nx; i++)
 	{					
 		f[0] += z[i]*z[i];
@@ -370,21 +1076,32 @@ void sphere_func (double *x, double *f, int nx, double *Os, double *Mr, int s_fl
 
 
 
-void ellips_func (double *x, double *f, int nx, double *Os,double *Mr, int s_flag, int r_flag) /* Ellipsoidal */
+void ellips_func (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr, int s_flag, int r_flag) /* Ellipsoidal */
 {
+	double *z=ws->z;
     int i;
 	f[0] = 0.0;
-	sr_func (x, z, nx, Os, Mr,1.0, s_flag, r_flag); /* shift and rotate */
+	sr_func (ws, x, z, nx, Os, Mr,1.0, s_flag, r_flag); /* shift and rotate */
+	if (nx<=COEF_DIMS)
+	{
+		double *coef=&ellips_coef[nx*(nx-1)/2];
+		for (i=0; i<nx; i++)
+		{
+			f[0] += coef[i]*z[i]*z[i];
+		}
+		return;
+	}
 	for (i=0; i<nx; i++)
 	{
        f[0] += pow(10.0,6.0*i/(nx-1))*z[i]*z[i];
 	}
 }
 
-void sum_diff_pow_func (double *x, double *f, int nx, double *Os,double *Mr, int s_flag, int r_flag) /* sum of different power */
+void sum_diff_pow_func (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr, int s_flag, int r_flag) /* sum of different power */
 {
+	double *z=ws->z;
     int i;
-	sr_func (x, z, nx, Os, Mr,1.0, s_flag, r_flag); // shift and rotate 
+	sr_func (ws, x, z, nx, Os, Mr,1.0, s_flag, r_flag); // shift and rotate 
 	f[0] = 0.0; 
 	double sum = 0.0;
 	for (i=0; i<nx; i++)
@@ -397,10 +1114,11 @@ void sum_diff_pow_func (double *x, double *f, int nx, double *Os,double *Mr, int
 	f[0] = sum;
 }
 
-void zakharov_func (double *x, double *f, int nx, double *Os,double *Mr, int s_flag, int r_flag) /* zakharov */
+void zakharov_func (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr, int s_flag, int r_flag) /* zakharov */
 {
+	double *z=ws->z;
 	int i;
-	sr_func (x, z, nx, Os, Mr,1.0, s_flag, r_flag); // shift and rotate 
+	sr_func (ws, x, z, nx, Os, Mr,1.0, s_flag, r_flag); // shift and rotate 
 	f[0] = 0.0; 
 	double sum1 = 0.0;
 	double sum2 = 0.0;
@@ -415,14 +1133,12 @@ void zakharov_func (double *x, double *f, int nx, double *Os,double *Mr, int s_f
 }
 
 /* Levy function */
-void levy_func (double *x, double *f, int nx, double *Os,double *Mr, int s_flag, int r_flag) /* Levy */
+void levy_func (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr, int s_flag, int r_flag) /* Levy */
 {
+	double *z=ws->z,*w=ws->tmp;
     int i;
 	f[0] = 0.0;
-	sr_func (x, z, nx, Os, Mr,1.0, s_flag, r_flag); /* shift and rotate */
-	
-	double *w;
-	w=(double *)malloc(sizeof(double)  *  nx);
+	sr_func (ws, x, z, nx, Os, Mr,1.0, s_flag, r_flag); /* shift and rotate */
 
 	for (i=0; i<nx; i++)
 	{
@@ -442,15 +1158,15 @@ void levy_func (double *x, double *f, int nx, double *Os,double *Mr, int s_flag,
 	}
 	
 	f[0] = term1 + sum + term3;
-	free(w);   // ADD THIS LINE to free memory! Thanks for Dr. Janez
 }
 
 /* Dixon and Price */
-void dixon_price_func (double *x, double *f, int nx, double *Os,double *Mr, int s_flag, int r_flag) /* Dixon and Price */
+void dixon_price_func (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr, int s_flag, int r_flag) /* Dixon and Price */
 {
+	double *z=ws->z;
 	int i;
 	int j;
-	sr_func (x, z, nx, Os, Mr,1.0, s_flag, r_flag); // shift and rotate 
+	sr_func (ws, x, z, nx, Os, Mr,1.0, s_flag, r_flag); // shift and rotate 
 	f[0] = 0;
 	double x1 = z[0];;
 	double term1 = pow((x1-1),2);
@@ -467,10 +1183,11 @@ void dixon_price_func (double *x, double *f, int nx, double *Os,double *Mr, int
 	f[0] = term1 + sum;
 }
 
-void bent_cigar_func (double *x, double *f, int nx, double *Os,double *Mr, int s_flag, int r_flag) /* Bent_Cigar */
+void bent_cigar_func (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr, int s_flag, int r_flag) /* Bent_Cigar */
 {
+	double *z=ws->z;
     int i;
-	sr_func (x, z, nx, Os, Mr,1.0, s_flag, r_flag); /* shift and rotate */
+	sr_func (ws, x, z, nx, Os, Mr,1.0, s_flag, r_flag); /* shift and rotate */
 
 	f[0] = z[0]*z[0];
 	for (i=1; i<nx; i++)
@@ -481,10 +1198,11 @@ void bent_cigar_func (double *x, double *f, int nx, double *Os,double *Mr, int s
 
 }
 
-void discus_func (double *x, double *f, int nx, double *Os,double *Mr, int s_flag, int r_flag) /* Discus */
+void discus_func (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr, int s_flag, int r_flag) /* Discus */
 {
+	double *z=ws->z;
     int i;
-	sr_func (x, z, nx, Os, Mr,1.0, s_flag, r_flag); /* shift and rotate */
+	sr_func (ws, x, z, nx, Os, Mr,1.0, s_flag, r_flag); /* shift and rotate */
 	f[0] = pow(10.0,6.0)*z[0]*z[0];
 	for (i=1; i<nx; i++)
 	{
@@ -492,26 +1210,39 @@ void discus_func (double *x, double *f, int nx, double *Os,double *Mr, int s_fla
 	}
 }
 
-void dif_powers_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* Different Powers */
+void dif_powers_func (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* Different Powers */
 {
+	double *z=ws->z;
 	int i;
 	f[0] = 0.0;
-	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
+	sr_func (ws, x, z, nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
 
-	for (i=0; i<nx; i++)
+	if (nx<=COEF_DIMS)
+	{
+		double *coef=&dif_powers_coef[nx*(nx-1)/2];
+		for (i=0; i<nx; i++)
+		{
+			f[0] += pow(fabs(z[i]),coef[i]);
+		}
+	}
+	else
 	{
-		f[0] += pow(fabs(z[i]),2+4*i/(nx-1));
+		for (i=0; i<nx; i++)
+		{
+			f[0] += pow(fabs(z[i]),2+4*i/(nx-1));
+		}
 	}
 	f[0]=pow(f[0],0.5);
 }
 
 
-void rosenbrock_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* Rosenbrock's */
+void rosenbrock_func (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* Rosenbrock's */
 {
+	double *z=ws->z;
     int i;
 	double tmp1,tmp2;
 	f[0] = 0.0;
-	sr_func (x, z, nx, Os, Mr, 2.048/100.0, s_flag, r_flag); /* shift and rotate */
+	sr_func (ws, x, z, nx, Os, Mr, 2.048/100.0, s_flag, r_flag); /* shift and rotate */
 	z[0] += 1.0;//shift to orgin
 	for (i=0; i<nx-1; i++)
 	{
@@ -522,12 +1253,13 @@ void rosenbrock_func (double *x, double *f, int nx, double *Os,double *Mr,int s_
 	}
 }
 
-void schaffer_F7_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* Schwefel's 1.2  */
+void schaffer_F7_func (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* Schwefel's 1.2  */
 {
+	double *y=ws->y,*z=ws->z;
     int i;
 	double tmp;
     f[0] = 0.0;
-	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
+	sr_func (ws, x, z, nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
 	for (i=0; i<nx-1; i++)	
 	{
 		z[i]=pow(y[i]*y[i]+y[i+1]*y[i+1],0.5);
@@ -537,15 +1269,21 @@ void schaffer_F7_func (double *x, double *f, int nx, double *Os,double *Mr,int s
 	f[0] = f[0]*f[0]/(nx-1)/(nx-1);
 }
 
-void ackley_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* Ackley's  */
+void ackley_func (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* Ackley's  */
 {
+	double *z=ws->z;
     int i;
     double sum1, sum2;
     sum1 = 0.0;
     sum2 = 0.0;
 
-	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
+	sr_func (ws, x, z, nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
 
+#ifdef CEC17_SIMD
+	if (ws->flags&CEC17_FLAG_SIMD)
+		cec17_simd_ackley(z,nx,&sum1,&sum2);
+	else
+#endif
 	for (i=0; i<nx; i++)
 	{
 		sum1 += z[i]*z[i];
@@ -557,41 +1295,43 @@ void ackley_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag
 }
 
 
-void weierstrass_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* Weierstrass's  */
+void weierstrass_func (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* Weierstrass's  */
 {
-    int i,j,k_max;
-    double sum,sum2, a, b;
-    a = 0.5;
-    b = 3.0;
-    k_max = 20;
+	double *z=ws->z;
+    int i,j;
+    double sum;
     f[0] = 0.0;
 
-	sr_func (x, z, nx, Os, Mr, 0.5/100.0, s_flag, r_flag); /* shift and rotate */
+	sr_func (ws, x, z, nx, Os, Mr, 0.5/100.0, s_flag, r_flag); /* shift and rotate */
 
 	for (i=0; i<nx; i++)
 	{
 		sum = 0.0;
-		sum2 = 0.0;
-		for (j=0; j<=k_max; j++)
+		for (j=0; j<=WEIERSTRASS_K; j++)
 		{
-			sum += pow(a,j)*cos(2.0*PI*pow(b,j)*(z[i]+0.5));
-			sum2 += pow(a,j)*cos(2.0*PI*pow(b,j)*0.5);
+			sum += weierstrass_a[j]*cos(weierstrass_b[j]*(z[i]+0.5));
 		}
 		f[0] += sum;
 	}
-	f[0] -= nx*sum2;
+	f[0] -= nx*weierstrass_sum2;
 }
 
 
-void griewank_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* Griewank's  */
+void griewank_func (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* Griewank's  */
 {
+	double *z=ws->z;
     int i;
     double s, p;
     s = 0.0;
     p = 1.0;
 
-	sr_func (x, z, nx, Os, Mr, 600.0/100.0, s_flag, r_flag); /* shift and rotate */
+	sr_func (ws, x, z, nx, Os, Mr, 600.0/100.0, s_flag, r_flag); /* shift and rotate */
 
+#ifdef CEC17_SIMD
+	if (ws->flags&CEC17_FLAG_SIMD)
+		cec17_simd_griewank(z,nx,&s,&p);
+	else
+#endif
 	for (i=0; i<nx; i++)
 	{
 		s += z[i]*z[i];
@@ -600,21 +1340,28 @@ void griewank_func (double *x, double *f, int nx, double *Os,double *Mr,int s_fl
 	f[0] = 1.0 + s/4000.0 - p;
 }
 
-void rastrigin_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* Rastrigin's  */
+void rastrigin_func (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* Rastrigin's  */
 {
+	double *z=ws->z;
     int i;
 	f[0] = 0.0;
 
-	sr_func (x, z, nx, Os, Mr, 5.12/100.0, s_flag, r_flag); /* shift and rotate */
+	sr_func (ws, x, z, nx, Os, Mr, 5.12/100.0, s_flag, r_flag); /* shift and rotate */
 
+#ifdef CEC17_SIMD
+	if (ws->flags&CEC17_FLAG_SIMD)
+		f[0]=cec17_simd_rastrigin(z,nx);
+	else
+#endif
 	for (i=0; i<nx; i++)
 	{
 		f[0] += (z[i]*z[i] - 10.0*cos(2.0*PI*z[i]) + 10.0);
 	}
 }
 
-void step_rastrigin_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* Noncontinuous Rastrigin's  */
+void step_rastrigin_func (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* Noncontinuous Rastrigin's  */
 {
+	double *y=ws->y,*z=ws->z;
     int i;
 	f[0]=0.0;
 	for (i=0; i<nx; i++)
@@ -623,22 +1370,33 @@ void step_rastrigin_func (double *x, double *f, int nx, double *Os,double *Mr,in
 		y[i]=Os[i]+floor(2*(y[i]-Os[i])+0.5)/2;
 	}
 
-	sr_func (x, z, nx, Os, Mr, 5.12/100.0, s_flag, r_flag); /* shift and rotate */
+	sr_func (ws, x, z, nx, Os, Mr, 5.12/100.0, s_flag, r_flag); /* shift and rotate */
 
+#ifdef CEC17_SIMD
+	if (ws->flags&CEC17_FLAG_SIMD)
+		f[0]=cec17_simd_rastrigin(z,nx);
+	else
+#endif
 	for (i=0; i<nx; i++)
 	{
 		f[0] += (z[i]*z[i] - 10.0*cos(2.0*PI*z[i]) + 10.0);
 	}
 }
 
-void schwefel_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* Schwefel's  */
+void schwefel_func (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* Schwefel's  */
 {
+	double *z=ws->z;
     int i;
 	double tmp;
 	f[0]=0.0;
 
-	sr_func (x, z, nx, Os, Mr, 1000.0/100.0, s_flag, r_flag); /* shift and rotate */
+	sr_func (ws, x, z, nx, Os, Mr, 1000.0/100.0, s_flag, r_flag); /* shift and rotate */
 
+#ifdef CEC17_SIMD
+	if (ws->flags&CEC17_FLAG_SIMD)
+		f[0]=cec17_simd_schwefel(z,nx);
+	else
+#endif
 	for (i=0; i<nx; i++)
 	{
 		z[i] += 4.209687462275036e+002;
@@ -661,21 +1419,22 @@ void schwefel_func (double *x, double *f, int nx, double *Os,double *Mr,int s_fl
 
 }
 
-void katsuura_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* Katsuura  */
+void katsuura_func (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* Katsuura  */
 {
+	double *z=ws->z;
     int i,j;
 	double temp,tmp1,tmp2,tmp3;
 	f[0]=1.0;
 	tmp3=pow(1.0*nx,1.2);
 
-	sr_func (x, z, nx, Os, Mr, 5.0/100.0, s_flag, r_flag); /* shift and rotate */
+	sr_func (ws, x, z, nx, Os, Mr, 5.0/100.0, s_flag, r_flag); /* shift and rotate */
 
     for (i=0; i<nx; i++)
 	{
 		temp=0.0;
-		for (j=1; j<=32; j++)
+		for (j=1; j<=KATSUURA_J; j++)
 		{
-			tmp1=pow(2.0,j);
+			tmp1=katsuura_pow[j];
 			tmp2=tmp1*z[i];
 			temp += fabs(tmp2-floor(tmp2+0.5))/tmp1;
 		}
@@ -686,12 +1445,11 @@ void katsuura_func (double *x, double *f, int nx, double *Os,double *Mr,int s_fl
 
 }
 
-void bi_rastrigin_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* Lunacek Bi_rastrigin Function */
+void bi_rastrigin_func (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* Lunacek Bi_rastrigin Function */
 {
+	double *y=ws->y,*z=ws->z,*tmpx=ws->tmp;
     int i;
 	double mu0=2.5,d=1.0,s,mu1,tmp,tmp1,tmp2;
-	double *tmpx;
-	tmpx=(double *)malloc(sizeof(double)  *  nx);
 	s=1.0-1.0/(2.0*pow(nx+20.0,0.5)-8.2);
 	mu1=-pow((mu0*mu0-d)/s,0.5);
 
@@ -734,7 +1492,12 @@ void bi_rastrigin_func (double *x, double *f, int nx, double *Os,double *Mr,int
 
 	if (r_flag==1)
 	{
-		rotatefunc(z, y, nx, Mr);
+		work_rotate(ws, z, y, nx, Mr);
+#ifdef CEC17_SIMD
+		if (ws->flags&CEC17_FLAG_SIMD)
+			tmp=cec17_simd_cos_sum(y,nx);
+		else
+#endif
 		for (i=0; i<nx; i++)
 		{
 			tmp+=cos(2.0*PI*y[i]);
@@ -747,6 +1510,11 @@ void bi_rastrigin_func (double *x, double *f, int nx, double *Os,double *Mr,int
 	}
 	else
 	{
+#ifdef CEC17_SIMD
+		if (ws->flags&CEC17_FLAG_SIMD)
+			tmp=cec17_simd_cos_sum(z,nx);
+		else
+#endif
 		for (i=0; i<nx; i++)
 		{
 			tmp+=cos(2.0*PI*z[i]);
@@ -757,18 +1525,24 @@ void bi_rastrigin_func (double *x, double *f, int nx, double *Os,double *Mr,int
 			f[0] = tmp2;
 		f[0] += 10.0*(nx-tmp);
 	}
-
-	free(tmpx);
 }
 
-void grie_rosen_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* Griewank-Rosenbrock  */
+void grie_rosen_func (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* Griewank-Rosenbrock  */
 {
+	double *z=ws->z;
     int i;
     double temp,tmp1,tmp2;
     f[0]=0.0;
 
-	sr_func (x, z, nx, Os, Mr, 5.0/100.0, s_flag, r_flag); /* shift and rotate */
+	sr_func (ws, x, z, nx, Os, Mr, 5.0/100.0, s_flag, r_flag); /* shift and rotate */
 
+#ifdef CEC17_SIMD
+	if (ws->flags&CEC17_FLAG_SIMD)
+	{
+		f[0]=cec17_simd_grie_rosen(z,nx);
+		return;
+	}
+#endif
 	z[0] += 1.0;//shift to orgin
     for (i=0; i<nx-1; i++)
     {
@@ -785,13 +1559,21 @@ void grie_rosen_func (double *x, double *f, int nx, double *Os,double *Mr,int s_
 }
 
 
-void escaffer6_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* Expanded Scaffer??s F6  */
+void escaffer6_func (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* Expanded Scaffer??s F6  */
 {
+	double *z=ws->z;
     int i;
     double temp1, temp2;
 
-	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
+	sr_func (ws, x, z, nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
 
+#ifdef CEC17_SIMD
+	if (ws->flags&CEC17_FLAG_SIMD)
+	{
+		f[0]=cec17_simd_escaffer6(z,nx);
+		return;
+	}
+#endif
     f[0] = 0.0;
     for (i=0; i<nx-1; i++)
     {
@@ -806,14 +1588,15 @@ void escaffer6_func (double *x, double *f, int nx, double *Os,double *Mr,int s_f
     f[0] += 0.5 + (temp1-0.5)/(temp2*temp2);
 }
 
-void happycat_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* HappyCat, provdided by Hans-Georg Beyer (HGB) */
+void happycat_func (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* HappyCat, provdided by Hans-Georg Beyer (HGB) */
 /* original global optimum: [-1,-1,...,-1] */
 {
+	double *z=ws->z;
 	int i;
 	double alpha,r2,sum_z;
 	alpha=1.0/8.0;
 	
-	sr_func (x, z, nx, Os, Mr, 5.0/100.0, s_flag, r_flag); /* shift and rotate */
+	sr_func (ws, x, z, nx, Os, Mr, 5.0/100.0, s_flag, r_flag); /* shift and rotate */
 
 	r2 = 0.0;
 	sum_z=0.0;
@@ -826,14 +1609,15 @@ void happycat_func (double *x, double *f, int nx, double *Os,double *Mr,int s_fl
     f[0]=pow(fabs(r2-nx),2*alpha) + (0.5*r2 + sum_z)/nx + 0.5;
 }
 
-void hgbat_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* HGBat, provdided by Hans-Georg Beyer (HGB)*/
+void hgbat_func (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag) /* HGBat, provdided by Hans-Georg Beyer (HGB)*/
 /* original global optimum: [-1,-1,...,-1] */
 {
+	double *z=ws->z;
 	int i;
 	double alpha,r2,sum_z;
 	alpha=1.0/4.0;
 
-	sr_func (x, z, nx, Os, Mr, 5.0/100.0, s_flag, r_flag); /* shift and rotate */
+	sr_func (ws, x, z, nx, Os, Mr, 5.0/100.0, s_flag, r_flag); /* shift and rotate */
 
 	r2 = 0.0;
 	sum_z=0.0;
@@ -846,8 +1630,9 @@ void hgbat_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag,
     f[0]=pow(fabs(pow(r2,2.0)-pow(sum_z,2.0)),2*alpha) + (0.5*r2 + sum_z)/nx + 0.5;
 }
 
-void hf01 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag) /* Hybrid Function 1 */
+void hf01 (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag) /* Hybrid Function 1 */
 {
+	double *y=ws->y;
 	int i,tmp,cf_num=3;
 	double fit[3];
 	int G[3],G_nx[3];
@@ -866,18 +1651,13 @@ void hf01 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag
 		G[i] = G[i-1]+G_nx[i-1];
 	}
 
-	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
-
-	for (i=0; i<nx; i++)
-	{
-		y[i]=z[S[i]-1];
-	}
+	hf_sr_func (ws, x, nx, Os, Mr, S, s_flag, r_flag); /* shift, rotate and shuffle */
 	i=0;
-	zakharov_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	zakharov_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=1;
-	rosenbrock_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	rosenbrock_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=2;
-	rastrigin_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	rastrigin_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	f[0]=0.0;
 	for(i=0;i<cf_num;i++)
 	{
@@ -885,8 +1665,9 @@ void hf01 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag
 	}
 }
 
-void hf02 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag) /* Hybrid Function 2 */
+void hf02 (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag) /* Hybrid Function 2 */
 {
+	double *y=ws->y;
 	int i,tmp,cf_num=3;
 	double fit[3];
 	int G[3],G_nx[3];
@@ -906,18 +1687,13 @@ void hf02 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag
 		G[i] = G[i-1]+G_nx[i-1];
 	}
 
-	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
-
-	for (i=0; i<nx; i++)
-	{
-		y[i]=z[S[i]-1];
-	}
+	hf_sr_func (ws, x, nx, Os, Mr, S, s_flag, r_flag); /* shift, rotate and shuffle */
 	i=0;
-	ellips_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	ellips_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=1;
-	schwefel_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	schwefel_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=2;
-	bent_cigar_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	bent_cigar_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 
 	f[0]=0.0;
 	for(i=0;i<cf_num;i++)
@@ -926,8 +1702,9 @@ void hf02 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag
 	}
 }
 
-void hf03 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag) /* Hybrid Function 2 */
+void hf03 (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag) /* Hybrid Function 2 */
 {
+	double *y=ws->y;
 	int i,tmp,cf_num=3;
 	double fit[3];
 	int G[3],G_nx[3];
@@ -947,19 +1724,14 @@ void hf03 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag
 		G[i] = G[i-1]+G_nx[i-1];
 	}
 
-	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
-
-	for (i=0; i<nx; i++)
-	{
-		y[i]=z[S[i]-1];
-	}
+	hf_sr_func (ws, x, nx, Os, Mr, S, s_flag, r_flag); /* shift, rotate and shuffle */
 	
 	i=0;
-	bent_cigar_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	bent_cigar_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=1;
-	rosenbrock_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	rosenbrock_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=2;
-	bi_rastrigin_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	bi_rastrigin_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 
 	f[0]=0.0;
 	for(i=0;i<cf_num;i++)
@@ -969,8 +1741,9 @@ void hf03 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag
 	
 }
 
-void hf04 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag) /* Hybrid Function 3 */
+void hf04 (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag) /* Hybrid Function 3 */
 {
+	double *y=ws->y;
 	int i,tmp,cf_num=4;
 	double fit[4];
 	int G[4],G_nx[4];
@@ -990,20 +1763,15 @@ void hf04 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag
 		G[i] = G[i-1]+G_nx[i-1];
 	}
 
-	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
-
-	for (i=0; i<nx; i++)
-	{
-		y[i]=z[S[i]-1];
-	}
+	hf_sr_func (ws, x, nx, Os, Mr, S, s_flag, r_flag); /* shift, rotate and shuffle */
 	i=0;
-	ellips_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	ellips_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=1;
-	ackley_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	ackley_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=2;
-	schaffer_F7_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	schaffer_F7_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=3;
-	rastrigin_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	rastrigin_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	
 	f[0]=0.0;
 	for(i=0;i<cf_num;i++)
@@ -1012,8 +1780,9 @@ void hf04 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag
 	}
 }
 
-void hf05 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag) /* Hybrid Function 4 */
+void hf05 (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag) /* Hybrid Function 4 */
 {
+	double *y=ws->y;
 	int i,tmp,cf_num=4;
 	double fit[4];
 	int G[4],G_nx[4];
@@ -1033,21 +1802,16 @@ void hf05 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag
 		G[i] = G[i-1]+G_nx[i-1];
 	}
 
-	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
-
-	for (i=0; i<nx; i++)
-	{
-		y[i]=z[S[i]-1];
-	}
+	hf_sr_func (ws, x, nx, Os, Mr, S, s_flag, r_flag); /* shift, rotate and shuffle */
 	i=0;
 	
-	bent_cigar_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	bent_cigar_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=1;
-	hgbat_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	hgbat_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=2;
-	rastrigin_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	rastrigin_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=3;
-	rosenbrock_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	rosenbrock_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	
 	f[0]=0.0;
 	for(i=0;i<cf_num;i++)
@@ -1055,8 +1819,9 @@ void hf05 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag
 		f[0] += fit[i];
 	}
 }
-void hf06 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag) /* Hybrid Function 5 */
+void hf06 (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag) /* Hybrid Function 5 */
 {
+	double *y=ws->y;
 	int i,tmp,cf_num=4;
 	double fit[4];
 	int G[4],G_nx[4];
@@ -1076,20 +1841,15 @@ void hf06 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag
 		G[i] = G[i-1]+G_nx[i-1];
 	}
 
-	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
-
-	for (i=0; i<nx; i++)
-	{
-		y[i]=z[S[i]-1];
-	}
+	hf_sr_func (ws, x, nx, Os, Mr, S, s_flag, r_flag); /* shift, rotate and shuffle */
 	i=0;
-	escaffer6_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	escaffer6_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=1;
-	hgbat_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	hgbat_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=2;
-	rosenbrock_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	rosenbrock_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=3;
-	schwefel_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	schwefel_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	
 	f[0]=0.0;
 	for(i=0;i<cf_num;i++)
@@ -1098,8 +1858,9 @@ void hf06 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag
 	}
 }
 
-void hf07 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag) /* Hybrid Function 6 */
+void hf07 (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag) /* Hybrid Function 6 */
 {
+	double *y=ws->y;
 	int i,tmp,cf_num=5;
 	double fit[5];
 	int G[5],G_nx[5];
@@ -1119,22 +1880,17 @@ void hf07 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag
 		G[i] = G[i-1]+G_nx[i-1];
 	}
 
-	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
-
-	for (i=0; i<nx; i++)
-	{
-		y[i]=z[S[i]-1];
-	}
+	hf_sr_func (ws, x, nx, Os, Mr, S, s_flag, r_flag); /* shift, rotate and shuffle */
 	i=0;
-	katsuura_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	katsuura_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=1;
-	ackley_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	ackley_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=2;
-	grie_rosen_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	grie_rosen_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=3;
-	schwefel_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	schwefel_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=4;
-	rastrigin_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	rastrigin_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 
 	f[0]=0.0;
 	for(i=0;i<cf_num;i++)
@@ -1143,8 +1899,9 @@ void hf07 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag
 	}
 }
 
-void hf08 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag) /* Hybrid Function 6 */
+void hf08 (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag) /* Hybrid Function 6 */
 {
+	double *y=ws->y;
 	int i,tmp,cf_num=5;
 	double fit[5];
 	int G[5],G_nx[5];
@@ -1164,23 +1921,18 @@ void hf08 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag
 		G[i] = G[i-1]+G_nx[i-1];
 	}
 
-	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
-
-	for (i=0; i<nx; i++)
-	{
-		y[i]=z[S[i]-1];
-	}
+	hf_sr_func (ws, x, nx, Os, Mr, S, s_flag, r_flag); /* shift, rotate and shuffle */
 	
 	i=0;
-	ellips_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	ellips_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=1;
-	ackley_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	ackley_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=2;
-	rastrigin_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	rastrigin_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=3;
-	hgbat_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	hgbat_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=4;
-	discus_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	discus_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 
 	f[0]=0.0;
 	for(i=0;i<cf_num;i++)
@@ -1189,8 +1941,9 @@ void hf08 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag
 	}
 }
 
-void hf09 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag) /* Hybrid Function 6 */
+void hf09 (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag) /* Hybrid Function 6 */
 {
+	double *y=ws->y;
 	int i,tmp,cf_num=5;
 	double fit[5];
 	int G[5],G_nx[5];
@@ -1210,23 +1963,18 @@ void hf09 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag
 		G[i] = G[i-1]+G_nx[i-1];
 	}
 
-	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
-
-	for (i=0; i<nx; i++)
-	{
-		y[i]=z[S[i]-1];
-	}
+	hf_sr_func (ws, x, nx, Os, Mr, S, s_flag, r_flag); /* shift, rotate and shuffle */
 	
 	i=0;
-	bent_cigar_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	bent_cigar_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=1;
-	rastrigin_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	rastrigin_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=2;
-	grie_rosen_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	grie_rosen_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=3;
-	weierstrass_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	weierstrass_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=4;
-	escaffer6_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	escaffer6_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 
 	f[0]=0.0;
 	for(i=0;i<cf_num;i++)
@@ -1236,8 +1984,9 @@ void hf09 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag
 }
 
 
-void hf10 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag) /* Hybrid Function 6 */
+void hf10 (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag) /* Hybrid Function 6 */
 {
+	double *y=ws->y;
 	int i,tmp,cf_num=6;
 	double fit[6];
 	int G[6],G_nx[6];
@@ -1257,25 +2006,20 @@ void hf10 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag
 		G[i] = G[i-1]+G_nx[i-1];
 	}
 
-	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
-
-	for (i=0; i<nx; i++)
-	{
-		y[i]=z[S[i]-1];
-	}
+	hf_sr_func (ws, x, nx, Os, Mr, S, s_flag, r_flag); /* shift, rotate and shuffle */
 	
 	i=0;
-	hgbat_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	hgbat_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=1;
-	katsuura_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	katsuura_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=2;
-	ackley_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	ackley_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=3;
-	rastrigin_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	rastrigin_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=4;
-	schwefel_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	schwefel_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 	i=5;
-	schaffer_F7_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
+	schaffer_F7_func(ws,&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0);
 
 	f[0]=0.0;
 	for(i=0;i<cf_num;i++)
@@ -1284,7 +2028,7 @@ void hf10 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag
 	}
 }
 
-void cf01 (double *x, double *f, int nx, double *Os,double *Mr,int r_flag) /* Composition Function 1 */
+void cf01 (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int r_flag) /* Composition Function 1 */
 {
 	int i,cf_num=3;
 	double fit[3];
@@ -1292,16 +2036,19 @@ void cf01 (double *x, double *f, int nx, double *Os,double *Mr,int r_flag) /* Co
 	double bias[3] = {0, 100, 200};
 	
 	i=0;
-	rosenbrock_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	rosenbrock_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	i=1;
-	ellips_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	ellips_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	fit[i]=10000*fit[i]/1e+10;
 	i=2;
-	rastrigin_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
-	cf_cal(x, f, nx, Os, delta,bias,fit,cf_num); 
+	cf_pre(ws,nx,i,r_flag);
+	rastrigin_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_cal(ws, f, nx, delta,bias,fit,cf_num); 
 }
 
-void cf02 (double *x, double *f, int nx, double *Os,double *Mr,int r_flag) /* Composition Function 2 */
+void cf02 (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int r_flag) /* Composition Function 2 */
 {
 	int i,cf_num=3;
 	double fit[3];
@@ -1309,16 +2056,19 @@ void cf02 (double *x, double *f, int nx, double *Os,double *Mr,int r_flag) /* Co
 	double bias[3] = {0, 100, 200};
 
 	i=0;
-	rastrigin_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	rastrigin_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	i=1;
-	griewank_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	griewank_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	fit[i]=1000*fit[i]/100;
 	i=2;
-	schwefel_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
-	cf_cal(x, f, nx, Os, delta,bias,fit,cf_num);
+	cf_pre(ws,nx,i,r_flag);
+	schwefel_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_cal(ws, f, nx, delta,bias,fit,cf_num);
 }
 
-void cf03 (double *x, double *f, int nx, double *Os,double *Mr,int r_flag) /* Composition Function 3 */
+void cf03 (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int r_flag) /* Composition Function 3 */
 {
 	int i,cf_num=4;
 	double fit[4];
@@ -1326,18 +2076,22 @@ void cf03 (double *x, double *f, int nx, double *Os,double *Mr,int r_flag) /* Co
 	double bias[4] = {0, 100, 200, 300};
 	
 	i=0;
-	rosenbrock_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	rosenbrock_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	i=1;
-	ackley_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	ackley_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	fit[i]=1000*fit[i]/100;
 	i=2;
-	schwefel_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	schwefel_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	i=3;
-	rastrigin_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
-	cf_cal(x, f, nx, Os, delta,bias,fit,cf_num); 
+	cf_pre(ws,nx,i,r_flag);
+	rastrigin_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_cal(ws, f, nx, delta,bias,fit,cf_num); 
 	
 }
-void cf04 (double *x, double *f, int nx, double *Os,double *Mr,int r_flag) /* Composition Function 3 */
+void cf04 (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int r_flag) /* Composition Function 3 */
 {
 	int i,cf_num=4;
 	double fit[4];
@@ -1345,120 +2099,146 @@ void cf04 (double *x, double *f, int nx, double *Os,double *Mr,int r_flag) /* Co
 	double bias[4] = {0, 100, 200, 300};
 	
 	i=0;
-	ackley_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	ackley_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	fit[i]=1000*fit[i]/100;
 	i=1;
-	ellips_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	ellips_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	fit[i]=10000*fit[i]/1e+10;
 	i=2;
-	griewank_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	griewank_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	fit[i]=1000*fit[i]/100;
 	i=3;
-	rastrigin_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
-	cf_cal(x, f, nx, Os, delta,bias,fit,cf_num);
+	cf_pre(ws,nx,i,r_flag);
+	rastrigin_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_cal(ws, f, nx, delta,bias,fit,cf_num);
 }
 
-void cf05 (double *x, double *f, int nx, double *Os,double *Mr,int r_flag) /* Composition Function 4 */
+void cf05 (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int r_flag) /* Composition Function 4 */
 {
 	int i,cf_num=5;
 	double fit[5];
 	double delta[5] = {10,20,30,40,50};
 	double bias[5] = {0, 100, 200, 300, 400};
 	i=0;
-	rastrigin_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	rastrigin_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	fit[i]=10000*fit[i]/1e+3;
 	i=1;
-	happycat_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	happycat_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	fit[i]=1000*fit[i]/1e+3;
 	i=2;
-	ackley_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	ackley_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	fit[i]=1000*fit[i]/100;
 	i=3;
-	discus_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	discus_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	fit[i]=10000*fit[i]/1e+10;	
 	i=4;
-	rosenbrock_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
-	cf_cal(x, f, nx, Os, delta,bias,fit,cf_num);
+	cf_pre(ws,nx,i,r_flag);
+	rosenbrock_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_cal(ws, f, nx, delta,bias,fit,cf_num);
 }		
 
 
-void cf06 (double *x, double *f, int nx, double *Os,double *Mr,int r_flag) /* Composition Function 4 */
+void cf06 (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int r_flag) /* Composition Function 4 */
 {
 	int i,cf_num=5;
 	double fit[5];
 	double delta[5] = {10,20,20,30,40};
 	double bias[5] = {0, 100, 200, 300, 400};
 	i=0;
-	escaffer6_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	escaffer6_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	fit[i]=10000*fit[i]/2e+7;
 	i=1;
-	schwefel_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	schwefel_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	i=2;
-	griewank_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	griewank_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	fit[i]=1000*fit[i]/100;
 	i=3;
-	rosenbrock_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	rosenbrock_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	i=4;
-	rastrigin_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	rastrigin_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	fit[i]=10000*fit[i]/1e+3;
-	cf_cal(x, f, nx, Os, delta,bias,fit,cf_num);
+	cf_cal(ws, f, nx, delta,bias,fit,cf_num);
 }
 
-void cf07 (double *x, double *f, int nx, double *Os,double *Mr,int r_flag) /* Composition Function 4 */
+void cf07 (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int r_flag) /* Composition Function 4 */
 {
 	int i,cf_num=6;
 	double fit[6];
 	double delta[6] = {10,20,30,40,50,60};
 	double bias[6] = {0, 100, 200, 300, 400, 500};
 	i=0;
-	hgbat_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	hgbat_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	fit[i]=10000*fit[i]/1000;
 	i=1;
-	rastrigin_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	rastrigin_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	fit[i]=10000*fit[i]/1e+3;
 	i=2;
-	schwefel_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	schwefel_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	fit[i]=10000*fit[i]/4e+3;
 	i=3;
-	bent_cigar_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	bent_cigar_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	fit[i]=10000*fit[i]/1e+30;
 	i=4;
-	ellips_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	ellips_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	fit[i]=10000*fit[i]/1e+10;
 	i=5;
-	escaffer6_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	escaffer6_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	fit[i]=10000*fit[i]/2e+7;
-	cf_cal(x, f, nx, Os, delta,bias,fit,cf_num); 
+	cf_cal(ws, f, nx, delta,bias,fit,cf_num); 
 }
 
-void cf08 (double *x, double *f, int nx, double *Os,double *Mr,int r_flag) /* Composition Function 4 */
+void cf08 (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int r_flag) /* Composition Function 4 */
 {	
 	int i,cf_num=6;
 	double fit[6];
 	double delta[6] = {10,20,30,40,50,60};
 	double bias[6] = {0, 100, 200, 300, 400, 500};
 	i=0;
-	ackley_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	ackley_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	fit[i]=1000*fit[i]/100;
 	i=1;
-	griewank_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	griewank_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	fit[i]=1000*fit[i]/100;
 	i=2;
-	discus_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	discus_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	fit[i]=10000*fit[i]/1e+10;
 	i=3;
-	rosenbrock_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	rosenbrock_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	i=4;
-	happycat_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	happycat_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	fit[i]=1000*fit[i]/1e+3;
 	i=5;
-	escaffer6_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	escaffer6_func(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag);
 	fit[i]=10000*fit[i]/2e+7;
-	cf_cal(x, f, nx, Os, delta,bias,fit,cf_num);
+	cf_cal(ws, f, nx, delta,bias,fit,cf_num);
 }
 
 
-void cf09 (double *x, double *f, int nx, double *Os,double *Mr,int *SS,int r_flag)
+void cf09 (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int *SS,int r_flag)
 {
 	
 	int i,cf_num=3;
@@ -1466,28 +2246,34 @@ void cf09 (double *x, double *f, int nx, double *Os,double *Mr,int *SS,int r_fla
 	double delta[3] = {10,30,50};
 	double bias[3] = {0, 100, 200};
 	i=0;
-	hf05(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],&SS[i*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	hf05(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],&SS[i*nx],1,r_flag);
 	i=1;
-	hf06(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],&SS[i*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	hf06(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],&SS[i*nx],1,r_flag);
 	i=2;
-	hf07(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],&SS[i*nx],1,r_flag);
-	cf_cal(x, f, nx, Os, delta,bias,fit,cf_num);
+	cf_pre(ws,nx,i,r_flag);
+	hf07(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],&SS[i*nx],1,r_flag);
+	cf_cal(ws, f, nx, delta,bias,fit,cf_num);
 		
 }
 
-void cf10 (double *x, double *f, int nx, double *Os,double *Mr,int *SS,int r_flag) 
+void cf10 (cec17_work *ws, double *x, double *f, int nx, double *Os,double *Mr,int *SS,int r_flag) 
 {
 	int i,cf_num=3;
 	double fit[3];
 	double delta[3] = {10,30,50};
 	double bias[3] = {0, 100, 200};
 	i=0;
-	hf05(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],&SS[i*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	hf05(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],&SS[i*nx],1,r_flag);
 	i=1;
-	hf08(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],&SS[i*nx],1,r_flag);
+	cf_pre(ws,nx,i,r_flag);
+	hf08(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],&SS[i*nx],1,r_flag);
 	i=2;
-	hf09(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],&SS[i*nx],1,r_flag);
-	cf_cal(x, f, nx, Os, delta,bias,fit,cf_num);
+	cf_pre(ws,nx,i,r_flag);
+	hf09(ws,x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],&SS[i*nx],1,r_flag);
+	cf_cal(ws, f, nx, delta,bias,fit,cf_num);
 }
 
 
@@ -1513,9 +2299,158 @@ void rotatefunc (double *x, double *xrot, int nx,double *Mr)
     }
 }
 
-void sr_func (double *x, double *sr_x, int nx, double *Os,double *Mr, double sh_rate, int s_flag,int r_flag) /* shift and rotate */
+void work_rotate (cec17_work *ws, double *x, double *xrot, int nx, double *Mr)
+{
+	if ((ws->flags&CEC17_FLAG_FIXED)&&nx==ws->fixed_nx)
+		ws->fixed.rotate(x, xrot, Mr);
+	else
+		rotatefunc(x, xrot, nx, Mr);
+}
+
+void sr_block (cec17_work *ws, double *x, int mx, int nx, double *Os,double *Mr, double sh_rate) /* shift and rotate a block */
+{
+	double *y=ws->block,*z=&ws->block[SR_BLOCK*nx],*yt=&ws->block[2*SR_BLOCK*nx];
+	int i,b;
+	if ((ws->flags&CEC17_FLAG_FIXED)&&nx==ws->fixed_nx)
+	{
+		ws->fixed.sr_block(x, mx, Os, Mr, sh_rate, ws->block);
+		return;
+	}
+	for (b=0; b<SR_BLOCK; b++)
+	{
+		for (i=0; i<nx; i++)
+		{
+			if (b<mx)
+			{
+				y[b*nx+i]=x[b*nx+i]-Os[i];
+				y[b*nx+i]=y[b*nx+i]*sh_rate;
+				yt[i*SR_BLOCK+b]=y[b*nx+i];
+			}
+			else
+				yt[i*SR_BLOCK+b]=0.0;
+		}
+	}
+	rotate_block(ws, yt, mx, nx, Mr, z);
+}
+
+void rotate_block (cec17_work *ws, double *yt, int mx, int nx, double *Mr, double *z) /* rotate a transposed block */
 {
+	double acc[SR_BLOCK],m;
+	int i,j,b;
+	if ((ws->flags&CEC17_FLAG_FIXED)&&nx==ws->fixed_nx)
+	{
+		ws->fixed.rotate_block(yt, mx, Mr, z);
+		return;
+	}
+	/* Each row of Mr is read once for the whole block, and every solution
+	   still sums its products in the same order as rotatefunc */
+	for (i=0; i<nx; i++)
+	{
+		for (b=0; b<SR_BLOCK; b++)
+			acc[b]=0;
+		for (j=0; j<nx; j++)
+		{
+			m=Mr[i*nx+j];
+			for (b=0; b<SR_BLOCK; b++)
+				acc[b]=acc[b]+yt[j*SR_BLOCK+b]*m;
+		}
+		for (b=0; b<mx; b++)
+			z[b*nx+i]=acc[b];
+	}
+}
+
+void cf_block (cec17_work *ws, double *x, int mx, int nx, double *Os,double *Mr, const double *sh_rate, int cf_num) /* shift and rotate a block for every component */
+{
+	double *yt=&ws->block[2*SR_BLOCK*nx];
+	double *y,*d;
+	int c,i,b;
+	/* Mr holds the cf_num matrices one after the other, so the components
+	   are rotated as a (cf_num*nx) x nx product. The pass that shifts a
+	   component also sums the distances of cf_cal. */
+	for (c=0; c<cf_num; c++)
+	{
+		y=&ws->cf_y[c*SR_BLOCK*nx];
+		d=&ws->cf_dist[c*SR_BLOCK];
+		for (b=0; b<SR_BLOCK; b++)
+		{
+			if (b<mx)
+			{
+				d[b]=0;
+				for (i=0; i<nx; i++)
+				{
+					y[b*nx+i]=x[b*nx+i]-Os[c*nx+i];
+					d[b]+=pow(y[b*nx+i],2.0);
+					y[b*nx+i]=y[b*nx+i]*sh_rate[c];
+					yt[i*SR_BLOCK+b]=y[b*nx+i];
+				}
+			}
+			else
+			{
+				for (i=0; i<nx; i++)
+					yt[i*SR_BLOCK+b]=0.0;
+			}
+		}
+		/* A single solution is faster without the padding of the block */
+		if (mx==1)
+			work_rotate(ws, y, &ws->cf_z[c*SR_BLOCK*nx], nx, &Mr[c*nx*nx]);
+		else
+			rotate_block(ws, yt, mx, nx, &Mr[c*nx*nx], &ws->cf_z[c*SR_BLOCK*nx]);
+	}
+}
+
+void cf_pre (cec17_work *ws, int nx, int c, int r_flag) /* use the shift and rotation of a component done by cf_block */
+{
+	if (r_flag==1)
+	{
+		ws->pre_y=&ws->cf_y[(c*SR_BLOCK+ws->cf_row)*nx];
+		ws->pre_z=&ws->cf_z[(c*SR_BLOCK+ws->cf_row)*nx];
+	}
+}
+
+void hf_sr_func (cec17_work *ws, double *x, int nx, double *Os,double *Mr, int *S, int s_flag,int r_flag) /* shift, rotate and shuffle */
+{
+	double *y=ws->y,*z=ws->z;
 	int i;
+	if (ws->pre_z!=NULL)
+	{
+		/* done by sr_block with the rest of the block */
+		for (i=0; i<nx; i++)
+		{
+			y[i]=ws->pre_z[i];
+		}
+		ws->pre_y=ws->pre_z=NULL;
+		return;
+	}
+	if (r_flag==1)
+	{
+		/* The rows of Mr are already in the order of S (see fold_shuffle),
+		   so the rotation leaves the genes shuffled in y */
+		sr_func (ws, x, z, nx, Os, Mr, 1.0, s_flag, 0);
+		work_rotate(ws, z, y, nx, Mr);
+		return;
+	}
+	sr_func (ws, x, z, nx, Os, Mr, 1.0, s_flag, r_flag);
+	for (i=0; i<nx; i++)
+	{
+		y[i]=z[S[i]-1];
+	}
+}
+
+void sr_func (cec17_work *ws, double *x, double *sr_x, int nx, double *Os,double *Mr, double sh_rate, int s_flag,int r_flag) /* shift and rotate */
+{
+	double *y=ws->y;
+	int i;
+	if (ws->pre_z!=NULL)
+	{
+		/* done by sr_block with the rest of the block */
+		for (i=0; i<nx; i++)
+		{
+			y[i]=ws->pre_y[i];
+			sr_x[i]=ws->pre_z[i];
+		}
+		ws->pre_y=ws->pre_z=NULL;
+		return;
+	}
 	if (s_flag==1)
 	{
 		if (r_flag==1)
@@ -1525,7 +2460,7 @@ void sr_func (double *x, double *sr_x, int nx, double *Os,double *Mr, double sh_
 			{
 				y[i]=y[i]*sh_rate;
 			}
-			rotatefunc(y, sr_x, nx, Mr);
+			work_rotate(ws, y, sr_x, nx, Mr);
 		}
 		else
 		{
@@ -1545,7 +2480,7 @@ void sr_func (double *x, double *sr_x, int nx, double *Os,double *Mr, double sh_
 			{
 				y[i]=x[i]*sh_rate;
 			}
-			rotatefunc(y, sr_x, nx, Mr);
+			work_rotate(ws, y, sr_x, nx, Mr);
 		}
 		else
 		for (i=0; i<nx; i++)//shrink to the original search range
@@ -1599,20 +2534,15 @@ void oszfunc (double *x, double *xosz, int nx)
 }
 
 
-void cf_cal(double *x, double *f, int nx, double *Os,double * delta,double * bias,double * fit, int cf_num)
+void cf_cal(cec17_work *ws, double *f, int nx, double * delta,double * bias,double * fit, int cf_num)
 {
-	int i,j;
-	double *w;
+	int i;
+	double *w=ws->w;
 	double w_max=0,w_sum=0;
-	w=(double *)malloc(cf_num * sizeof(double));
 	for (i=0; i<cf_num; i++)
 	{
 		fit[i]+=bias[i];
-		w[i]=0;
-		for (j=0; j<nx; j++)
-		{
-			w[i]+=pow(x[j]-Os[i*nx+j],2.0);
-		}
+		w[i]=ws->cf_dist[i*SR_BLOCK+ws->cf_row]; /* summed by cf_block */
 		if (w[i]!=0)
 			w[i]=pow(1.0/w[i],0.5)*exp(-w[i]/2.0/nx/pow(delta[i],2.0));
 		else
@@ -1636,5 +2566,4 @@ void cf_cal(double *x, double *f, int nx, double *Os,double * delta,double * bia
     {
 		f[0]=f[0]+w[i]/w_sum*fit[i];
     }
-	free(w);
 }
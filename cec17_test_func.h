@@ -0,0 +1,185 @@
+#ifndef _CEC17_TEST_FUNC
+
+#define _CEC17_TEST_FUNC 1
+
+#include <stddef.h>
+
+/**
+ * Contexto de evaluación de una función del CEC17 para una dimensión.
+ *
+ * Referencia los vectores de desplazamiento, las matrices de rotación y los
+ * índices de barajado del problema (de solo lectura) y contiene la memoria
+ * auxiliar de los kernels, por lo que dos contextos distintos pueden
+ * evaluarse a la vez desde hilos distintos. Un mismo contexto no debe usarse
+ * desde dos hilos simultáneamente.
+ */
+typedef struct cec17_context cec17_context;
+
+/**
+ * Crea un contexto cargando los datos de input_data.
+ * @param func_num debe ser entre 1 y 30.
+ * @param nx debe ser 2, 10, 20, 30, 50 o 100.
+ * @return contexto, o NULL si no se han podido cargar los datos.
+ */
+cec17_context *cec17_context_create(int func_num, int nx);
+
+/**
+ * Libera el contexto y todos sus datos.
+ */
+void cec17_context_destroy(cec17_context *ctx);
+
+/**
+ * Devuelve la función asociada al contexto.
+ */
+int cec17_context_funcid(const cec17_context *ctx);
+
+/**
+ * Devuelve la dimensión asociada al contexto.
+ */
+int cec17_context_dimension(const cec17_context *ctx);
+
+/**
+ * Devuelve cuántas veces ha reservado el contexto su memoria auxiliar. Toda
+ * la memoria que usan los kernels al evaluar se reserva de una vez al crear
+ * el contexto (o al asociarlo a una dimensión mayor), de modo que evaluar no
+ * hace ninguna reserva en el heap.
+ */
+unsigned long cec17_context_allocations(const cec17_context *ctx);
+
+/**
+ * Opciones de evaluación de un contexto.
+ */
+enum {
+  /* Bucles vectoriales en las funciones básicas con senos y cosenos (no
+     idénticos bit a bit a los escalares). Solo disponible si la librería se
+     compila con la opción CEC17_SIMD, y en ese caso activo por defecto. */
+  CEC17_FLAG_SIMD = 1,
+  /* Rotaciones generadas para la dimensión del contexto (idénticas a las
+     genéricas). Activo por defecto. */
+  CEC17_FLAG_FIXED = 2
+};
+
+/**
+ * Cambia las opciones de evaluación de un contexto.
+ * @param flags combinación de CEC17_FLAG_*.
+ * @return opciones aplicadas (sin las que no están disponibles).
+ */
+int cec17_context_set_flags(cec17_context *ctx, int flags);
+
+/**
+ * Evalúa mx soluciones consecutivas.
+ * @param x matriz de mx filas con nx valores cada una.
+ * @param f vector donde se guardan los mx fitness.
+ */
+void cec17_context_evaluate(cec17_context *ctx, double *x, double *f, int mx);
+
+/**
+ * Estado de evaluación: vector que guarda, tras evaluar una solución, su
+ * desplazamiento y rotación (2 * nx valores). Si después solo cambian unos
+ * pocos genes, la solución puede volver a evaluarse actualizando la rotación
+ * con las columnas de esos genes (O(D k) en lugar de O(D^2)). El resultado
+ * puede diferir del de una evaluación completa en los últimos bits, y el error
+ * de redondeo se acumula con cada actualización: el estado debe recalcularse
+ * con cec17_context_evaluate_state tras unas 32 actualizaciones, o cuando
+ * cambie una cuarta parte de los genes o más, que ya no sale más barato.
+ */
+
+/**
+ * Tamaño del estado de evaluación del contexto.
+ * @return número de valores, o 0 si la función no lo admite (en ese caso las
+ * evaluaciones con estado son evaluaciones completas).
+ */
+int cec17_context_state_size(const cec17_context *ctx);
+
+/**
+ * Evalúa una solución guardando su estado de evaluación.
+ * @param state vector de cec17_context_state_size(ctx) valores.
+ */
+void cec17_context_evaluate_state(cec17_context *ctx, double *x, double *f,
+                                  double *state);
+
+/**
+ * Evalúa una solución de la que solo han cambiado algunos genes desde que se
+ * calculó su estado, y actualiza el estado.
+ * @param state estado de la solución antes de los cambios.
+ * @param changed índices de los genes cambiados (pueden repetirse).
+ * @param num_changed número de índices.
+ */
+void cec17_context_evaluate_delta(cec17_context *ctx, double *x, double *f,
+                                  double *state, const int *changed,
+                                  int num_changed);
+
+/**
+ * Los datos de cada función y dimensión se cargan una sola vez y quedan en
+ * una caché compartida por todos los contextos, de modo que crear contextos
+ * o alternar entre problemas no vuelve a leer los ficheros.
+ */
+
+/**
+ * Carga en la caché todos los problemas disponibles para una dimensión.
+ * @param nx dimensión, o 0 para todas las dimensiones.
+ * @return número de problemas cargados.
+ */
+int cec17_cache_preload(int nx);
+
+/**
+ * Limita la memoria (en bytes) que ocupan los problemas en la caché. Al
+ * superarse se liberan los problemas sin contextos usados hace más tiempo.
+ * @param bytes límite, o 0 para no limitar (por defecto).
+ */
+void cec17_cache_set_budget(size_t bytes);
+
+/**
+ * Devuelve la memoria (en bytes) que ocupan los problemas en la caché. Los
+ * datos proyectados desde el fichero empaquetado no cuentan.
+ */
+size_t cec17_cache_usage(void);
+
+/**
+ * Libera todos los problemas de la caché que no usa ningún contexto.
+ */
+void cec17_cache_clear(void);
+
+/**
+ * Devuelve el contexto por defecto asociado a una función y dimensión.
+ * @return contexto, o NULL si no se han podido cargar los datos.
+ */
+cec17_context *cec17_default_context(int func_num, int nx);
+
+/**
+ * Devuelve el contexto del hilo que llama asociado a una función y dimensión.
+ * Cada hilo tiene el suyo, que se asocia al problema de la caché cuando
+ * cambian la función o la dimensión y se libera al terminar el hilo.
+ * @return contexto, o NULL si no se han podido cargar los datos.
+ */
+cec17_context *cec17_thread_context(int func_num, int nx);
+
+/**
+ * Evalúa mx soluciones sobre un contexto por defecto, que se asocia al
+ * problema de la caché cuando cambian la función o la dimensión.
+ *
+ * Si la librería se compila con la opción CEC17_OPENMP y se activa con
+ * cec17_set_threads, los lotes grandes se reparten en trozos consecutivos
+ * entre varios hilos, cada uno con su propio contexto. Los resultados son
+ * los mismos (y en el mismo orden) que evaluando en serie. No debe llamarse
+ * desde varios hilos a la vez.
+ */
+void cec17_test_func(double *x, double *f, int nx, int mx, int func_num);
+
+/**
+ * Número de hilos con que cec17_test_func evalúa los lotes grandes.
+ * @param threads número de hilos, 1 para evaluar en serie (por defecto) o 0
+ * para usar todos los procesadores.
+ * @return hilos que se usarán (1 si no se ha compilado con CEC17_OPENMP).
+ */
+int cec17_set_threads(int threads);
+
+/**
+ * Filas mínimas que evalúa cada hilo: los lotes de menos de dos veces este
+ * número se evalúan en serie, ya que repartirlos cuesta más de lo que se
+ * gana.
+ * @param rows número de filas, o 0 para el valor por defecto (32).
+ */
+void cec17_set_grain(int rows);
+
+#endif
@@ -0,0 +1,171 @@
+#include "cec17_trace.h"
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Rows kept in memory before writing a block */
+#define TRACE_BLOCK 1024
+
+/* The blocks are written with write(2), without a stdio buffer, so that
+   everything but the rows in memory is already in the file when a signal
+   arrives */
+struct cec17_trace_file {
+  int fd;
+  pthread_mutex_t lock;
+  /* Set while the rows are changed or written, so that the signal handler
+     does not write a block halfway through */
+  atomic_int busy;
+  struct timespec start;
+  int rows;
+  int failed;
+  int64_t evaluation[TRACE_BLOCK];
+  double error[TRACE_BLOCK];
+  int64_t nanoseconds[TRACE_BLOCK];
+  int32_t generation[TRACE_BLOCK];
+};
+
+static int64_t elapsed(const struct timespec *start) {
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (int64_t)(now.tv_sec - start->tv_sec) * 1000000000 +
+         (now.tv_nsec - start->tv_nsec);
+}
+
+static int write_all(int fd, const void *data, size_t size) {
+  const char *p = (const char *)data;
+  ssize_t written;
+
+  while (size > 0) {
+    written = write(fd, p, size);
+    if (written <= 0) {
+      return 0;
+    }
+    p += written;
+    size -= written;
+  }
+  return 1;
+}
+
+/* Takes the busy flag, waiting only for the signal handler */
+static void acquire(cec17_trace_file *trace) {
+  int idle;
+
+  do {
+    idle = 0;
+  } while (!atomic_compare_exchange_weak(&trace->busy, &idle, 1));
+}
+
+/* Writes the pending rows as one block, with the busy flag taken. It only
+   makes async-signal-safe calls */
+static void write_block(cec17_trace_file *trace) {
+  struct cec17_trace_block block;
+  static const int32_t padding = 0;
+  size_t n = trace->rows;
+  int ok;
+
+  if (n == 0) {
+    return;
+  }
+  memcpy(block.tag, CEC17_TRACE_ROWS, sizeof(block.tag));
+  block.rows = n;
+  ok = write_all(trace->fd, &block, sizeof(block));
+  ok = ok && write_all(trace->fd, trace->evaluation, n * sizeof(int64_t));
+  ok = ok && write_all(trace->fd, trace->error, n * sizeof(double));
+  ok = ok && write_all(trace->fd, trace->nanoseconds, n * sizeof(int64_t));
+  ok = ok && write_all(trace->fd, trace->generation, n * sizeof(int32_t));
+  if (n % 2 == 1) {
+    ok = ok && write_all(trace->fd, &padding, sizeof(padding));
+  }
+  if (!ok) {
+    trace->failed = 1;
+  }
+  trace->rows = 0;
+}
+
+cec17_trace_file *cec17_trace_open(const char *fname, int funcid,
+                                   int dimension, long max_evals) {
+  struct cec17_trace_header header;
+  cec17_trace_file *trace =
+      (cec17_trace_file *)calloc(1, sizeof(cec17_trace_file));
+
+  if (trace == NULL) {
+    return NULL;
+  }
+  trace->fd = open(fname, O_WRONLY | O_APPEND | O_CREAT, 0644);
+  if (trace->fd < 0) {
+    free(trace);
+    return NULL;
+  }
+  pthread_mutex_init(&trace->lock, NULL);
+  clock_gettime(CLOCK_MONOTONIC, &trace->start);
+
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, CEC17_TRACE_MAGIC, sizeof(header.magic));
+  header.version = CEC17_TRACE_VERSION;
+  header.funcid = funcid;
+  header.dimension = dimension;
+  header.max_evals = max_evals;
+  if (!write_all(trace->fd, &header, sizeof(header))) {
+    trace->failed = 1;
+  }
+  return trace;
+}
+
+void cec17_trace_add(cec17_trace_file *trace, long evaluation, double error,
+                     int generation) {
+  int64_t ns = elapsed(&trace->start);
+
+  pthread_mutex_lock(&trace->lock);
+  acquire(trace);
+  if (trace->rows == TRACE_BLOCK) {
+    write_block(trace);
+  }
+  trace->evaluation[trace->rows] = evaluation;
+  trace->error[trace->rows] = error;
+  trace->nanoseconds[trace->rows] = ns;
+  trace->generation[trace->rows] = generation;
+  trace->rows++;
+  atomic_store(&trace->busy, 0);
+  pthread_mutex_unlock(&trace->lock);
+}
+
+int cec17_trace_flush(cec17_trace_file *trace) {
+  int ok;
+
+  pthread_mutex_lock(&trace->lock);
+  acquire(trace);
+  write_block(trace);
+  ok = !trace->failed;
+  atomic_store(&trace->busy, 0);
+  pthread_mutex_unlock(&trace->lock);
+  return ok;
+}
+
+void cec17_trace_flush_on_signal(cec17_trace_file *trace) {
+  int idle = 0;
+
+  if (atomic_compare_exchange_strong(&trace->busy, &idle, 1)) {
+    write_block(trace);
+    atomic_store(&trace->busy, 0);
+  }
+}
+
+int cec17_trace_close(cec17_trace_file *trace) {
+  int ok;
+
+  if (trace == NULL) {
+    return 1;
+  }
+  ok = cec17_trace_flush(trace);
+  if (close(trace->fd) != 0) {
+    ok = 0;
+  }
+  pthread_mutex_destroy(&trace->lock);
+  free(trace);
+  return ok;
+}
@@ -0,0 +1,77 @@
+#ifndef _CEC17_TRACE
+
+#define _CEC17_TRACE 1
+
+#include <stdint.h>
+
+/**
+ * Traza de convergencia: fichero binario, en el que solo se añaden datos, con
+ * el mejor error de una ejecución a lo largo de sus evaluaciones.
+ *
+ * Formato (orden de bytes nativo). Cada ejecución empieza con una cabecera y
+ * sigue con bloques de filas guardadas por columnas, así que un mismo fichero
+ * puede contener varias ejecuciones seguidas:
+ *   cabecera (32 bytes): magic "CEC17TRC", versión, función, dimensión, 0 y
+ *   evaluaciones máximas (int64).
+ *   bloque: marca "ROWS", número de filas n (int32) y las columnas: número de
+ *   evaluación (n int64), mejor error (n double), nanosegundos desde el
+ *   inicio de la traza (n int64) y generación (n int32), con 4 bytes de
+ *   relleno si n es impar.
+ *
+ * Hay una fila en cada evaluación que alcanza un hito, por lo que los hitos
+ * pueden obtenerse de la traza.
+ */
+#define CEC17_TRACE_MAGIC "CEC17TRC"
+#define CEC17_TRACE_ROWS "ROWS"
+#define CEC17_TRACE_VERSION 1
+
+struct cec17_trace_header {
+  char magic[8];
+  int32_t version;
+  int32_t funcid;
+  int32_t dimension;
+  int32_t reserved;
+  int64_t max_evals;
+};
+
+struct cec17_trace_block {
+  char tag[4];
+  int32_t rows;
+};
+
+typedef struct cec17_trace_file cec17_trace_file;
+
+/**
+ * Abre (o crea) una traza y añade la cabecera de una ejecución.
+ * @return traza, o NULL si no puede abrirse el fichero.
+ */
+cec17_trace_file *cec17_trace_open(const char *fname, int funcid,
+                                   int dimension, long max_evals);
+
+/**
+ * Añade una fila. Las filas se guardan en memoria y se escriben por bloques.
+ * Puede llamarse desde varios hilos a la vez.
+ */
+void cec17_trace_add(cec17_trace_file *trace, long evaluation, double error,
+                     int generation);
+
+/**
+ * Escribe las filas pendientes.
+ * @return 1 si se han escrito, 0 si hay error.
+ */
+int cec17_trace_flush(cec17_trace_file *trace);
+
+/**
+ * Escribe las filas pendientes desde un manejador de señales: solo hace
+ * llamadas seguras en él y no espera, así que no escribe nada si la señal
+ * llega mientras se añade o se escribe una fila.
+ */
+void cec17_trace_flush_on_signal(cec17_trace_file *trace);
+
+/**
+ * Escribe las filas pendientes, cierra el fichero y libera la traza.
+ * @return 1 si se han escrito, 0 si hay error.
+ */
+int cec17_trace_close(cec17_trace_file *trace);
+
+#endif
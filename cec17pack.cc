@@ -0,0 +1,20 @@
+extern "C" {
+#include "cec17_archive.h"
+}
+#include <iostream>
+
+using namespace std;
+
+// Packs input_data into a single binary archive. Run from the directory that
+// contains input_data; the archive is picked up automatically afterwards.
+int main(int argc, char *argv[]) {
+  const char *fname = argc > 1 ? argv[1] : CEC17_ARCHIVE_FILE;
+  int problems = cec17_archive_build(fname);
+
+  if (problems < 0) {
+    return 1;
+  }
+
+  cout << "Packed " << problems << " problems into " << fname << endl;
+  return 0;
+}
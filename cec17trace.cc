@@ -0,0 +1,43 @@
+#include "inc/trace_reader.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+
+// Prints a convergence trace as CSV, one line per row, or with --milestones
+// the milestone lines of every run, as in the results files.
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    cerr << "Usage: " << argv[0] << " trace [--milestones]" << endl;
+    return 1;
+  }
+
+  TraceReader reader(argv[1]);
+  bool milestones = argc > 2 && strcmp(argv[2], "--milestones") == 0;
+
+  if (!reader.is_open()) {
+    return 1;
+  }
+
+  if (milestones) {
+    cout << "funcid,dim,milestone,error" << endl;
+    for (const TraceRun &run : reader.runs()) {
+      cout << TraceReader::milestones_csv(run);
+    }
+    return 0;
+  }
+
+  cout << "run,funcid,dim,evaluation,generation,error,nanoseconds" << endl;
+  for (size_t r = 0; r < reader.runs().size(); ++r) {
+    const TraceRun &run = reader.runs()[r];
+    for (const TraceBlock &block : run.blocks) {
+      for (size_t i = 0; i < block.rows; ++i) {
+        printf("%zu,%d,%d,%lld,%d,%e,%lld\n", r, run.funcid, run.dimension,
+               (long long)block.evaluation[i], block.generation[i],
+               block.error[i], (long long)block.nanoseconds[i]);
+      }
+    }
+  }
+  return 0;
+}
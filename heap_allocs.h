@@ -0,0 +1,66 @@
+#ifndef __HEAP_ALLOCS_H
+#define __HEAP_ALLOCS_H
+
+#include <cerrno>
+#include <cstdlib>
+
+/**
+ * Counter of the heap allocations of the process, for the tests and
+ * benchmarks that check that some code does not allocate. With glibc,
+ * malloc, calloc, realloc, aligned_alloc, memalign and posix_memalign count
+ * every call before going on to the glibc allocator, so C++ new and the C
+ * library are counted too. Other C libraries count nothing. The functions
+ * are defined here, so a program may include this header from one file only.
+ */
+
+static unsigned long heap_allocs = 0;
+
+#if defined(__GLIBC__)
+#include <malloc.h> // Declared before they are replaced
+
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t num, size_t size);
+extern "C" void *__libc_realloc(void *ptr, size_t size);
+extern "C" void *__libc_memalign(size_t alignment, size_t size);
+
+extern "C" void *malloc(size_t size) {
+  heap_allocs++;
+  return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t num, size_t size) {
+  heap_allocs++;
+  return __libc_calloc(num, size);
+}
+
+extern "C" void *realloc(void *ptr, size_t size) {
+  heap_allocs++;
+  return __libc_realloc(ptr, size);
+}
+
+extern "C" void *aligned_alloc(size_t alignment, size_t size) {
+  heap_allocs++;
+  return __libc_memalign(alignment, size);
+}
+
+extern "C" void *memalign(size_t alignment, size_t size) {
+  heap_allocs++;
+  return __libc_memalign(alignment, size);
+}
+
+extern "C" int posix_memalign(void **ptr, size_t alignment, size_t size) {
+  heap_allocs++;
+  if (alignment == 0 || alignment % sizeof(void *) != 0 ||
+      (alignment & (alignment - 1)) != 0) {
+    return EINVAL;
+  }
+  void *memory = __libc_memalign(alignment, size);
+  if (memory == NULL) {
+    return ENOMEM;
+  }
+  *ptr = memory;
+  return 0;
+}
+#endif
+
+#endif // __HEAP_ALLOCS_H
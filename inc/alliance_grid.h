@@ -0,0 +1,73 @@
+#ifndef __ALLIANCE_GRID_H
+#define __ALLIANCE_GRID_H
+
+#include "population_matrix.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Grid over the first genes of the kings of a population, to find the
+ * castles that can ally without comparing every pair. Cells are twice the
+ * alliance threshold wide, so two near kings are at most one cell apart in
+ * every hashed gene, and the castles near a king are among the ones in its
+ * cell and the neighbouring ones. The cells are kept in a vector sorted by
+ * the hash of their coordinates
+ */
+class AllianceGrid {
+private:
+  static constexpr size_t max_grid_dimensions = 3; // Genes hashed, at most
+
+  size_t grid_dimensions = 0;           // Genes hashed
+  double cell_width = 0.0;              // Width of a cell in every gene
+  vector<pair<uint64_t, size_t>> cells; // Hash of the cell of every row
+  mutable vector<size_t> found;         // Candidates of the last query
+
+  /** @brief Get the cell of a king
+   *
+   * @param genes The chromosome of the king
+   * @param cell Where the coordinates of its cell are stored
+   */
+  void cell_of(const double *genes, int64_t *cell) const;
+
+  /** @brief Hash of the coordinates of a cell
+   *
+   * @param cell The coordinates
+   * @return The hash
+   */
+  uint64_t hash(const int64_t *cell) const;
+
+public:
+  /** @brief Reserve memory for a population
+   *
+   * @param rows The number of castles
+   */
+  void reserve(size_t rows) {
+    cells.reserve(rows);
+    found.reserve(rows);
+  }
+
+  /** @brief Index the kings of a population
+   *
+   * @param population The population
+   * @param epsilon The threshold for considering two knights equal
+   * @return False if the threshold is too small for the cells to be computed
+   * exactly (or not positive), so every pair must be compared
+   */
+  bool build(const PopulationMatrix &population, double epsilon);
+
+  /** @brief Get the castles after a castle that may ally with it: all the
+   * castles near it are included, but some may not be near
+   *
+   * @param population The population given to build
+   * @param i The row of the castle
+   * @return The rows after i in its cell and the neighbouring ones, in
+   * increasing order. Valid until the next query
+   */
+  const vector<size_t> &candidates(const PopulationMatrix &population,
+                                   size_t i) const;
+};
+
+#endif // __ALLIANCE_GRID_H
@@ -2,6 +2,7 @@
 #define __CASTLE_H
 
 #include "knight.h"
+#include <utility>
 #include <vector>
 
 using namespace std;
@@ -20,7 +21,7 @@ private:
    * @param x The input value
    * @return The sigmoid value of x
    */
-  double sigmoid(double x) const { return 1.0 / (1.0 + exp(-x)); }
+  static double sigmoid(double x) { return 1.0 / (1.0 + exp(-x)); }
 
 public:
   /** @brief Constructor to initialize the castle with a knight
@@ -33,27 +34,16 @@ public:
          const unsigned int war_exhaustion = 0)
       : king(knight), fitness(fitness), war_exhaustion(war_exhaustion) {}
 
-  /** @brief Copy Constructor
+  /** @brief Constructor to initialize the castle with a knight it takes over
    *
-   * @param other The castle to copy from
-   */
-  Castle(const Castle &other)
-      : king(other.king), fitness(other.fitness),
-        war_exhaustion(other.war_exhaustion) {}
-
-  /** @brief Assignment operator
-   *
-   * @param other The castle to assign from
-   * @return Reference to this castle
+   * @param knight The knight that owns the castle
+   * @param fitness The fitness value of the knight
+   * @param war_exhaustion The war exhaustion level of the castle
    */
-  Castle &operator=(const Castle &other) {
-    if (this != &other) {
-      king = other.king;
-      fitness = other.fitness;
-      war_exhaustion = other.war_exhaustion;
-    }
-    return *this;
-  }
+  Castle(Knight &&knight, const double fitness,
+         const unsigned int war_exhaustion = 0)
+      : king(std::move(knight)), fitness(fitness),
+        war_exhaustion(war_exhaustion) {}
 
   /** @brief Equality operator
    *
@@ -102,6 +92,18 @@ public:
    */
   bool siege(const Knight &knight, const double knight_fitness);
 
+  /** @brief Whether a knight takes a castle. It draws the same random numbers
+   * as siege, so castles stored elsewhere (such as in a PopulationMatrix) are
+   * sieged the same way
+   *
+   * @param castle_fitness The fitness value of the castle
+   * @param war_exhaustion The war exhaustion level of the castle
+   * @param knight_fitness The fitness value of the knight
+   * @return True if the siege is successful, false otherwise
+   */
+  static bool siege_succeeds(double castle_fitness, unsigned int war_exhaustion,
+                             double knight_fitness);
+
   /** @brief Check if can make an alliance with another castle. An alliance can
    * be made if both castles have an similar king.
    *
@@ -0,0 +1,171 @@
+#ifndef __CHROMOSOME_H
+#define __CHROMOSOME_H
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+using namespace std;
+
+/**
+ * @brief Genes of a knight. Up to inline_capacity genes (every CEC17
+ * dimension) are stored inside the object, aligned to a cache line, so
+ * creating, copying and assigning chromosomes does not allocate. Larger
+ * chromosomes fall back to aligned heap memory
+ */
+class Chromosome {
+public:
+  static constexpr size_t inline_capacity = 100; // Largest CEC17 dimension
+  static constexpr size_t alignment = 64;
+
+private:
+  alignas(alignment) double inline_genes[inline_capacity];
+  size_t dimension = 0;   // Number of genes
+  double *heap = nullptr; // Genes of chromosomes above inline_capacity
+
+  /** @brief Change the number of genes, keeping the first ones
+   *
+   * @param size The new number of genes
+   */
+  void reallocate(size_t size) {
+    if (size > inline_capacity) {
+      double *genes = static_cast<double *>(
+          ::operator new(size * sizeof(double), align_val_t(alignment)));
+      copy(data(), data() + min(dimension, size), genes);
+      release();
+      heap = genes;
+    } else if (heap != nullptr) {
+      copy(heap, heap + size, inline_genes);
+      release();
+    }
+    dimension = size;
+  }
+
+  /** @brief Free the heap genes, if any
+   */
+  void release() {
+    if (heap != nullptr) {
+      ::operator delete(heap, align_val_t(alignment));
+      heap = nullptr;
+    }
+  }
+
+public:
+  /** @brief Constructor
+   *
+   * @param size The number of genes
+   * @param value The value of every gene
+   */
+  explicit Chromosome(size_t size = 0, double value = 0.0) {
+    resize(size, value);
+  }
+
+  /** @brief Constructor to copy some genes
+   *
+   * @param genes The values to copy
+   * @param size The number of genes
+   */
+  Chromosome(const double *genes, size_t size) {
+    reallocate(size);
+    copy(genes, genes + size, data());
+  }
+
+  /** @brief Copy constructor. Copies only the genes in use
+   *
+   * @param other The chromosome to copy from
+   */
+  Chromosome(const Chromosome &other)
+      : Chromosome(other.data(), other.size()) {}
+
+  /** @brief Assignment operator
+   *
+   * @param other The chromosome to assign from
+   * @return Reference to this chromosome
+   */
+  Chromosome &operator=(const Chromosome &other) {
+    if (this != &other) {
+      if (other.size() != dimension) {
+        reallocate(other.size());
+      }
+      copy(other.data(), other.data() + dimension, data());
+    }
+    return *this;
+  }
+
+  /** @brief Move constructor. Takes the heap genes of the other
+   * chromosome, if any, and copies the inline ones
+   *
+   * @param other The chromosome to move from
+   */
+  Chromosome(Chromosome &&other) noexcept
+      : dimension(other.dimension), heap(other.heap) {
+    if (heap == nullptr) {
+      copy(other.inline_genes, other.inline_genes + dimension, inline_genes);
+    }
+    other.dimension = 0;
+    other.heap = nullptr;
+  }
+
+  /** @brief Move assignment operator
+   *
+   * @param other The chromosome to move from
+   * @return Reference to this chromosome
+   */
+  Chromosome &operator=(Chromosome &&other) noexcept {
+    if (this != &other) {
+      release();
+      dimension = other.dimension;
+      heap = other.heap;
+      if (heap == nullptr) {
+        copy(other.inline_genes, other.inline_genes + dimension, inline_genes);
+      }
+      other.dimension = 0;
+      other.heap = nullptr;
+    }
+    return *this;
+  }
+
+  ~Chromosome() { release(); }
+
+  /** @brief Change the number of genes
+   *
+   * @param size The new number of genes
+   * @param value The value of the new genes
+   */
+  void resize(size_t size, double value = 0.0) {
+    size_t old_size = dimension;
+    reallocate(size);
+    if (size > old_size) {
+      fill(data() + old_size, data() + size, value);
+    }
+  }
+
+  /** @brief Get the number of genes
+   *
+   * @return The dimension
+   */
+  size_t size() const { return dimension; }
+
+  /** @brief Whether there are no genes
+   *
+   * @return True if the dimension is 0
+   */
+  bool empty() const { return dimension == 0; }
+
+  /** @brief Get the genes
+   *
+   * @return Pointer to the first gene
+   */
+  double *data() { return heap != nullptr ? heap : inline_genes; }
+  const double *data() const { return heap != nullptr ? heap : inline_genes; }
+
+  double &operator[](size_t i) { return data()[i]; }
+  double operator[](size_t i) const { return data()[i]; }
+
+  double *begin() { return data(); }
+  double *end() { return data() + dimension; }
+  const double *begin() const { return data(); }
+  const double *end() const { return data() + dimension; }
+};
+
+#endif // __CHROMOSOME_H
@@ -1,8 +1,10 @@
 #ifndef __CSEA_H
 #define __CSEA_H
 
+#include "alliance_grid.h"
 #include "castle.h"
 #include "knight.h"
+#include "population_matrix.h"
 #include <vector>
 
 using namespace std;
@@ -17,11 +19,20 @@ struct CSEAArgs {
   double mutation_rate; // Mutation rate for the knights
   double sigma;         // Standard deviation for Gaussian mutation
   double epsilon;       // Threshold for considering two knights equal
+  size_t fitness_cache_size;   // Chromosomes in the fitness cache (0: none)
+  bool cache_hits_count;       // Whether cache hits count as evaluations
+  bool profile; // Measure the phases and evaluations, print them at the end
+  double target_error; // Stop once the best error is below it (0: never)
+  bool ziggurat_mutation; // Mutate in bulk with a Ziggurat normal sampler
 
   CSEAArgs(int pop_size, int dim, int max_gen = 1000, double mut_rate = 0.005,
-           double sig = 100.0, double eps = 1e-6)
+           double sig = 100.0, double eps = 1e-6, size_t cache_size = 0,
+           bool hits_count = true, bool profiling = false, double target = 0.0,
+           bool ziggurat = false)
       : population_size(pop_size), dimension(dim), max_evaluations(max_gen),
-        mutation_rate(mut_rate), sigma(sig), epsilon(eps) {}
+        mutation_rate(mut_rate), sigma(sig), epsilon(eps),
+        fitness_cache_size(cache_size), cache_hits_count(hits_count),
+        profile(profiling), target_error(target), ziggurat_mutation(ziggurat) {}
 };
 
 /**
@@ -35,7 +46,41 @@ struct CSEAResult {
 };
 
 /**
- * @brief Castle Siege Evolutionary Algorithm (CSEA)
+ * @brief Buffers kept across the generations of a run. They are reserved for
+ * the largest generation up front, so the generations reuse them instead of
+ * allocating new populations. The fitness cache of the run is kept here too,
+ * so that runs on different threads do not share it
+ */
+struct CSEABuffers {
+  PopulationMatrix knights; // The new generation of knights
+  PopulationMatrix allies;  // The population being formed by the alliances
+  vector<bool> allied;      // Whether each castle has already allied
+  AllianceGrid grid;        // Index of the kings to find the alliances
+  vector<double> uniforms;  // Random numbers of the crossover of a castle
+  MutationBuffers mutation; // Random numbers of the mutation
+  FitnessCache cache;       // Fitness of the chromosomes evaluated in the run
+
+  CSEABuffers(const CSEAArgs &args)
+      : knights(args.dimension), allies(args.dimension),
+        cache(args.fitness_cache_size, args.cache_hits_count) {
+    size_t num_knights = args.population_size * (args.population_size - 1) / 2;
+    knights.reserve(num_knights);
+    uniforms.reserve((args.population_size - 1) * args.dimension);
+    allies.reserve(args.population_size);
+    allied.reserve(args.population_size);
+    grid.reserve(args.population_size);
+  }
+};
+
+/**
+ * @brief Castle Siege Evolutionary Algorithm (CSEA). With a target error, the
+ * run ends as soon as the best error is below it, and the milestones not
+ * reached yet are written with that error (see cec17_finish)
+ *
+ * Several runs may go on at once in different threads: each one has its own
+ * buffers and fitness cache, draws from the random engine of its thread and
+ * evaluates on the cec17 session of its thread (see cec17_use_session). The
+ * profiler is shared by the process, so only one of them should profile
  *
  * @param args The arguments for the CSEA
  * @return Result of running the CSEA
@@ -47,9 +92,12 @@ CSEAResult csea(const CSEAArgs &args);
  *
  * @param population_size Number of castles to generate
  * @param dimension Dimension of the knight's chromosome
- * @return Vector of castles representing the first generation
+ * @param cache The fitness cache of the run
+ * @return Matrix of castles representing the first generation
  */
-vector<Castle> generate_initial_population(int population_size, int dimension);
+PopulationMatrix generate_initial_population(int population_size,
+                                             int dimension,
+                                             FitnessCache &cache);
 
 /**
  * @brief Generate a new generation of knights from the current population of
@@ -57,31 +105,38 @@ vector<Castle> generate_initial_population(int population_size, int dimension);
  *
  * @param population The current population of castles
  * @param args The arguments for the CSEA
- * @return Vector of knights representing the new generation
+ * @param buffers The buffers of the run, where the new generation of knights
+ * is stored, not evaluated
  */
-vector<Knight> generate_new_generation(const vector<Castle> &population,
-                                       const CSEAArgs &args);
+void generate_new_generation(const PopulationMatrix &population,
+                             const CSEAArgs &args, CSEABuffers &buffers);
 
 /**
- * @brief Siege the castles with the new generation of knights.
+ * @brief Siege the castles with the new generation of knights. The fitness
+ * column of the knights is filled in
  *
  * @param population The current population of castles
  * @param knights The new generation of knights
  * @param best Reference to the best knight found so far
+ * @param cache The fitness cache of the run
  */
-void siege_castles(vector<Castle> &population, const vector<Knight> &knights,
-                   CSEAResult &best);
+void siege_castles(PopulationMatrix &population, PopulationMatrix &knights,
+                   CSEAResult &best, FitnessCache &cache);
 
 /**
- * @brief Form alliances between castles based on their kings
+ * @brief Form alliances between castles based on their kings. The castles
+ * near each castle are found with the grid of the buffers, in the same order
+ * as comparing every pair. The new population is formed in the buffers and
+ * swapped with the current one
  *
- * @param population The current population of castles
+ * @param population The current population of castles, replaced by the
+ * castles after forming alliances
  * @param epsilon The threshold for considering two knights equal
  * @param best Reference to the best knight found so far
- * @return Vector of castles after forming alliances
+ * @param buffers The buffers of the run
  */
-vector<Castle> form_alliances(const vector<Castle> &population, double epsilon,
-                              CSEAResult &best);
+void form_alliances(PopulationMatrix &population, double epsilon,
+                    CSEAResult &best, CSEABuffers &buffers);
 
 /**
  * @brief Complete the population of castles by adding the best knight found if
@@ -92,9 +147,10 @@ vector<Castle> form_alliances(const vector<Castle> &population, double epsilon,
  * @param population The current population of castles
  * @param args The arguments for the CSEA
  * @param best Reference to the best knight found so far
+ * @param cache The fitness cache of the run
  */
-void complete_population(vector<Castle> &population, const CSEAArgs &args,
-                         CSEAResult &best);
+void complete_population(PopulationMatrix &population, const CSEAArgs &args,
+                         CSEAResult &best, FitnessCache &cache);
 
 /**
  * @brief Get an upper bound of evaluations in a generation
@@ -104,4 +160,13 @@ void complete_population(vector<Castle> &population, const CSEAArgs &args,
  */
 int get_evaluations_upper_bound(const CSEAArgs &args);
 
+/**
+ * @brief Whether the best fitness found is already within the target error
+ *
+ * @param args The arguments for the CSEA
+ * @param best The best knight found so far
+ * @return True if the run can stop
+ */
+bool target_reached(const CSEAArgs &args, const CSEAResult &best);
+
 #endif // __CSEA_H
@@ -0,0 +1,121 @@
+#ifndef __FITNESS_CACHE_H
+#define __FITNESS_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Bounded hash table from chromosomes to their fitness. Two
+ * chromosomes are the same key only if all their genes are bitwise equal
+ */
+class FitnessCache {
+private:
+  // Slots probed from the home slot of a key before replacing it
+  static constexpr size_t max_probes = 8;
+
+  size_t dimension = 0;  // Genes of every key, fixed by the first insertion
+  size_t mask = 0;       // Number of slots minus one (a power of two)
+  vector<double> keys;   // Chromosome of each slot, one after the other
+  vector<double> values; // Fitness of each slot
+  vector<uint64_t> hashes; // Hash of each slot, 0 if it is empty
+  unsigned long hit_count = 0;
+  unsigned long miss_count = 0;
+  bool count_hits = true; // Whether hits count as evaluations
+
+  /** @brief Hash of the bits of a chromosome, never 0
+   *
+   * @param genes The chromosome values
+   * @param size The number of values
+   * @return The hash value
+   */
+  static uint64_t hash(const double *genes, size_t size);
+
+  /** @brief Whether a slot holds the given chromosome
+   *
+   * @param slot The slot index
+   * @param key_hash The hash of the chromosome
+   * @param genes The chromosome values
+   * @return True if the slot holds it
+   */
+  bool matches(size_t slot, uint64_t key_hash, const double *genes) const;
+
+public:
+  /** @brief Constructor
+   *
+   * @param capacity Maximum number of chromosomes kept, rounded up to a power
+   * of two. 0 disables the cache
+   * @param hits_count True if the hits count as evaluations of the benchmark
+   */
+  explicit FitnessCache(size_t capacity = 0, bool hits_count = true);
+
+  /** @brief Whether the cache keeps any chromosome
+   *
+   * @return True if its capacity is not 0
+   */
+  bool enabled() const { return !hashes.empty(); }
+
+  /** @brief Whether a fitness taken from the cache is recorded as an
+   * evaluation of the benchmark
+   *
+   * @return True if the hits count
+   */
+  bool hits_counted() const { return count_hits; }
+
+  /** @brief Look up the fitness of a chromosome, counting a hit or a miss
+   *
+   * @param chromosome The chromosome to look up
+   * @param fitness Set to the cached fitness on a hit
+   * @return True on a hit
+   */
+  bool lookup(const vector<double> &chromosome, double &fitness) {
+    return lookup(chromosome.data(), chromosome.size(), fitness);
+  }
+
+  /** @brief Look up the fitness of the genes of a matrix row
+   *
+   * @param genes The chromosome values
+   * @param size The number of values
+   * @param fitness Set to the cached fitness on a hit
+   * @return True on a hit
+   */
+  bool lookup(const double *genes, size_t size, double &fitness);
+
+  /** @brief Store the fitness of a chromosome. When its slots are all in use
+   * the entry in its home slot is replaced
+   *
+   * @param chromosome The evaluated chromosome
+   * @param fitness Its fitness value
+   */
+  void insert(const vector<double> &chromosome, double fitness) {
+    insert(chromosome.data(), chromosome.size(), fitness);
+  }
+
+  /** @brief Store the fitness of the genes of a matrix row
+   *
+   * @param genes The chromosome values
+   * @param size The number of values
+   * @param fitness Its fitness value
+   */
+  void insert(const double *genes, size_t size, double fitness);
+
+  /** @brief Remove every entry and reset the counters
+   */
+  void clear();
+
+  /** @brief Number of lookups that found the chromosome
+   *
+   * @return The hit count
+   */
+  unsigned long hits() const { return hit_count; }
+
+  /** @brief Number of lookups that did not find the chromosome
+   *
+   * @return The miss count
+   */
+  unsigned long misses() const { return miss_count; }
+};
+
+#endif // __FITNESS_CACHE_H
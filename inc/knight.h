@@ -6,17 +6,31 @@
 extern "C" {
 #include "../cec17.h"
 }
+#include "chromosome.h"
+#include "fitness_cache.h"
 #include "random.hpp"
+#include "ziggurat.h"
 #include <vector>
 
 using namespace std;
 
 /**
- * @brief Class to represent a knight chromosome
+ * @brief Random numbers drawn in bulk by Knight::gaussian_mutation_block. The
+ * caller keeps them, so that every run reuses its own memory
+ */
+struct MutationBuffers {
+  vector<int> counts;    // Number of mutations of every chromosome
+  vector<int> indices;   // Genes to mutate
+  vector<double> values; // Values added to them
+};
+
+/**
+ * @brief Class to represent a knight chromosome. Its only state is the inline
+ * chromosome, so the implicit copy and move operations do not allocate
  */
 class Knight {
 private:
-  vector<double> chromosome; // Vector to hold the chromosome values
+  Chromosome chromosome; // Chromosome values, stored inline
 
   /** @brief BLX-alpha crossover operation
    *
@@ -43,23 +57,13 @@ public:
    */
   Knight(int dimension, bool randomize = true, double radius = 100.0);
 
-  /** @brief Copy constructor
+  /** @brief Constructor to copy the chromosome of a matrix row
    *
-   * @param other The knight to copy from
-   */
-  Knight(const Knight &other) : chromosome(other.chromosome) {}
-
-  /** @brief Assignment operator
-   *
-   * @param other The knight to assign from
-   * @return Reference to this knight
+   * @param genes The chromosome values
+   * @param dimension The size of the chromosome
    */
-  Knight &operator=(const Knight &other) {
-    if (this != &other) {
-      chromosome = other.chromosome;
-    }
-    return *this;
-  }
+  Knight(const double *genes, int dimension)
+      : chromosome(genes, dimension) {}
 
   /** @brief Equality operator
    *
@@ -68,15 +72,8 @@ public:
    * @return True if the chromosomes are equal, false otherwise
    */
   bool operator==(const Knight &other) const {
-    for (size_t i = 0; i < chromosome.size(); ++i) {
-      if (abs(chromosome[i] - other.chromosome[i]) >
-          numeric_limits<double>::epsilon()) {
-        {
-          return false;
-        }
-      }
-    }
-    return true;
+    return is_near(chromosome.data(), other.chromosome.data(),
+                   chromosome.size(), numeric_limits<double>::epsilon());
   }
 
   /** @brief Is near operator
@@ -87,8 +84,22 @@ public:
    * @return True if the chromosomes are near equal, false otherwise
    */
   bool is_near(const Knight &other, double epsilon = 1e-6) const {
-    for (size_t i = 0; i < chromosome.size(); ++i) {
-      if (abs(chromosome[i] - other.chromosome[i]) > epsilon) {
+    return is_near(chromosome.data(), other.chromosome.data(),
+                   chromosome.size(), epsilon);
+  }
+
+  /** @brief Is near operator on two chromosomes, such as matrix rows
+   *
+   * @param genes1 The first chromosome
+   * @param genes2 The second chromosome
+   * @param size The size of both chromosomes
+   * @param epsilon The tolerance for comparison
+   * @return True if the chromosomes are near equal, false otherwise
+   */
+  static bool is_near(const double *genes1, const double *genes2, size_t size,
+                      double epsilon) {
+    for (size_t i = 0; i < size; ++i) {
+      if (abs(genes1[i] - genes2[i]) > epsilon) {
         return false;
       }
     }
@@ -118,28 +129,167 @@ public:
     gaussian_mutation(mutation_rate, 100.0);
   }
 
+  /** @brief Get the chromosome values
+   *
+   * @return Pointer to the genes
+   */
+  const double *data() const { return chromosome.data(); }
+
+  /** @brief Get the size of the chromosome
+   *
+   * @return The dimension of the knight
+   */
+  int size() const { return chromosome.size(); }
+
+  /** @brief Fill a chromosome, such as a matrix row, with random values. It
+   * draws the same random numbers as the randomizing constructor
+   *
+   * @param genes Where the values are stored
+   * @param dimension The size of the chromosome
+   * @param radius The range of the random values
+   */
+  static void random_genes(double *genes, int dimension,
+                           double radius = 100.0);
+
+  /** @brief BLX-alpha crossover of two chromosomes, such as matrix rows. It
+   * draws the same random numbers as cross
+   *
+   * @param parent1 First parent chromosome
+   * @param parent2 Second parent chromosome
+   * @param child Where the new chromosome is stored
+   * @param dimension The size of the chromosomes
+   */
+  static void blx_alpha(const double *parent1, const double *parent2,
+                        double *child, int dimension);
+
+  /** @brief BLX-alpha crossover of a chromosome with a block of consecutive
+   * matrix rows, such as a castle with all the castles after it. The random
+   * numbers of the whole block are drawn at once, and are the same that
+   * calling blx_alpha for each row would draw
+   *
+   * @param parent1 First parent chromosome
+   * @param parents2 The second parent of every child, one after the other
+   * @param count The number of children
+   * @param children Where the new chromosomes are stored, one after the other
+   * @param dimension The size of the chromosomes
+   * @param uniforms Where the random numbers of the block are kept
+   */
+  static void blx_alpha_block(const double *parent1, const double *parents2,
+                              size_t count, double *children, int dimension,
+                              vector<double> &uniforms);
+
+  /** @brief Gaussian mutation of a chromosome, such as a matrix row. It draws
+   * the same random numbers as mutate
+   *
+   * @param chromosome The chromosome to mutate
+   * @param dimension The size of the chromosome
+   * @param mutation_rate The rate of mutation
+   * @param radius The standard deviation of the mutation
+   */
+  static void gaussian_mutation(double *chromosome, int dimension,
+                                double mutation_rate, double radius);
+
+  /** @brief Gaussian mutation of a block of chromosomes, such as the rows of a
+   * matrix. Without the Ziggurat sampler, it draws the same random numbers as
+   * mutating every row with gaussian_mutation. With it, the number of
+   * mutations of every row, their genes and their values are drawn in bulk,
+   * the values by the Ziggurat method, so the random numbers are different
+   *
+   * @param chromosomes The chromosomes, one after the other
+   * @param count The number of chromosomes
+   * @param dimension The size of every chromosome
+   * @param mutation_rate The rate of mutation
+   * @param radius The standard deviation of the mutation
+   * @param ziggurat Whether to draw in bulk with the Ziggurat sampler
+   * @param buffers Where the numbers drawn in bulk are kept
+   */
+  static void gaussian_mutation_block(double *chromosomes, size_t count,
+                                      int dimension, double mutation_rate,
+                                      double radius, bool ziggurat,
+                                      MutationBuffers &buffers);
+
+  /** @brief Evaluate a chromosome, such as a matrix row. With a fitness
+   * cache, a chromosome bitwise equal to one already evaluated takes its
+   * fitness from the cache instead of evaluating it again
+   *
+   * @param genes The chromosome values
+   * @param dimension The size of the chromosome
+   * @param cache The fitness cache of the run, if any
+   * @return The fitness value
+   */
+  static double evaluate(const double *genes, int dimension,
+                         FitnessCache *cache = nullptr);
+
   /** @brief Return the fitness of the knight
    *
    * @return The fitness value
    */
   double fitness() const {
-    double fitness = cec17_fitness(const_cast<double *>(chromosome.data()));
+    return evaluate(chromosome.data(), chromosome.size());
+  }
+
+  /** @brief Evaluate a group of knights in a single call
+   *
+   * @pre All the knights must have the same dimension
+   * @param knights The knights to evaluate
+   * @return The fitness value of each knight, in the same order
+   */
+  static vector<double> batch_fitness(const vector<Knight> &knights);
+
+  /** @brief Evaluate the rows of a row-major matrix of chromosomes in a single
+   * call, like batch_fitness
+   *
+   * @param matrix The chromosomes, one after the other
+   * @param rows The number of chromosomes
+   * @param dimension The size of every chromosome
+   * @param fitness Where the fitness of each row is stored
+   * @param cache The fitness cache of the run, if any
+   */
+  static void batch_fitness(const double *matrix, size_t rows, size_t dimension,
+                            double *fitness, FitnessCache *cache = nullptr);
+
+private:
+  /** @brief Draw uniform numbers in [0, 1) from the engine of Random. They are
+   * the same numbers that uniform_real_distribution draws in libstdc++ (two
+   * outputs of the engine for each number), so that scaling them gives the
+   * values of Random::get<double>
+   *
+   * @param values Where the numbers are stored
+   * @param n The number of values
+   */
+  static void uniform_block(double *values, size_t n);
 
+  /** @brief Record a fitness taken from the cache as an evaluation, if the
+   * hits count
+   *
+   * @param cache The cache it was taken from
+   * @param fitness The cached fitness
+   */
+  static void record_cache_hit(const FitnessCache &cache, double fitness) {
+    if (cache.hits_counted()) {
+      cec17_record(fitness);
+    }
+  }
+
+  /** @brief Abort the run if a chromosome is out of the search bounds
+   *
+   * @param genes The chromosome values
+   * @param size The size of the chromosome
+   */
+  static void check_bounds(const double *genes, size_t size) {
     // Calculate distance (max distance)
     double distance = 0.0;
-    for(size_t i = 0; i < chromosome.size(); ++i) {
-      distance = max(distance, abs(chromosome[i]));
+    for(size_t i = 0; i < size; ++i) {
+      distance = max(distance, abs(genes[i]));
     }
     if(distance > 100.0) {
       // Print chromosome if distance is greater than 100
       cout << "Chromosome exceeds bounds: ";
-      for (const auto &gene : chromosome) {
-        cout << gene << " ";
+      for (size_t i = 0; i < size; ++i) {
+        cout << genes[i] << " ";
       }
       exit(1);
     }
-
-    return fitness;
   }
 };
 
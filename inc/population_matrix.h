@@ -0,0 +1,184 @@
+#ifndef __POPULATION_MATRIX_H
+#define __POPULATION_MATRIX_H
+
+#include "knight.h"
+#include <cstddef>
+#include <new>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Allocator of memory aligned to a cache line
+ */
+template <typename T> struct AlignedAllocator {
+  using value_type = T;
+  static constexpr size_t alignment = 64;
+
+  AlignedAllocator() = default;
+  template <typename U> AlignedAllocator(const AlignedAllocator<U> &) {}
+
+  T *allocate(size_t n) {
+    return static_cast<T *>(
+        ::operator new(n * sizeof(T), align_val_t(alignment)));
+  }
+
+  void deallocate(T *p, size_t) {
+    ::operator delete(p, align_val_t(alignment));
+  }
+
+  template <typename U> bool operator==(const AlignedAllocator<U> &) const {
+    return true;
+  }
+  template <typename U> bool operator!=(const AlignedAllocator<U> &) const {
+    return false;
+  }
+};
+
+/**
+ * @brief Population of castles stored as a structure of arrays: the kings'
+ * chromosomes in one aligned row-major block, and the fitness and war
+ * exhaustion of every castle in parallel arrays. Row i is castle i, so the
+ * whole population can be evaluated or scanned without chasing pointers
+ */
+class PopulationMatrix {
+private:
+  size_t dimension;                          // Genes of every row
+  vector<double, AlignedAllocator<double>> genes; // Rows one after the other
+  vector<double> fitness;                    // Fitness of every row
+  vector<unsigned int> war_exhaustion;       // War exhaustion of every row
+
+public:
+  /** @brief Constructor
+   *
+   * @param dimension The size of every chromosome
+   * @param rows The initial number of rows, with zero genes
+   */
+  explicit PopulationMatrix(size_t dimension = 0, size_t rows = 0)
+      : dimension(dimension), genes(rows * dimension), fitness(rows),
+        war_exhaustion(rows) {}
+
+  /** @brief Get the number of rows
+   *
+   * @return The number of castles
+   */
+  size_t size() const { return fitness.size(); }
+
+  /** @brief Get the size of every chromosome
+   *
+   * @return The dimension
+   */
+  size_t get_dimension() const { return dimension; }
+
+  /** @brief Reserve memory for a number of rows
+   *
+   * @param rows The number of rows
+   */
+  void reserve(size_t rows);
+
+  /** @brief Change the number of rows. New rows have zero genes
+   *
+   * @param rows The number of rows
+   */
+  void resize(size_t rows);
+
+  /** @brief Remove every row, keeping the memory
+   */
+  void clear() { resize(0); }
+
+  /** @brief Get the genes of a row
+   *
+   * @param i The row index
+   * @return Pointer to its dimension genes
+   */
+  double *row(size_t i) { return genes.data() + i * dimension; }
+  const double *row(size_t i) const { return genes.data() + i * dimension; }
+
+  /** @brief Get the fitness of a row
+   *
+   * @param i The row index
+   * @return Reference to its fitness value
+   */
+  double &fitness_at(size_t i) { return fitness[i]; }
+  double fitness_at(size_t i) const { return fitness[i]; }
+
+  /** @brief Get the fitness column
+   *
+   * @return Pointer to the fitness of every row
+   */
+  double *fitness_data() { return fitness.data(); }
+
+  /** @brief Get the war exhaustion of a row
+   *
+   * @param i The row index
+   * @return Reference to its war exhaustion level
+   */
+  unsigned int &war_exhaustion_at(size_t i) { return war_exhaustion[i]; }
+  unsigned int war_exhaustion_at(size_t i) const { return war_exhaustion[i]; }
+
+  /** @brief Append a row
+   *
+   * @pre genes must not point into this matrix
+   * @param row_genes The chromosome of the new row
+   * @param row_fitness Its fitness value
+   * @param row_war_exhaustion Its war exhaustion level
+   */
+  void push_back(const double *row_genes, double row_fitness,
+                 unsigned int row_war_exhaustion = 0);
+
+  /** @brief Append a row of another matrix
+   *
+   * @param other The matrix to copy from
+   * @param i The row index in other
+   */
+  void push_back(const PopulationMatrix &other, size_t i) {
+    push_back(other.row(i), other.fitness[i], other.war_exhaustion[i]);
+  }
+
+  /** @brief Overwrite a row
+   *
+   * @param i The row index
+   * @param row_genes The new chromosome
+   * @param row_fitness Its fitness value
+   * @param row_war_exhaustion Its war exhaustion level
+   */
+  void set_row(size_t i, const double *row_genes, double row_fitness,
+               unsigned int row_war_exhaustion = 0);
+
+  /** @brief Less than operator of castles: by fitness, then by war
+   * exhaustion
+   *
+   * @param i The first row index
+   * @param j The second row index
+   * @return True if castle i is less than castle j
+   */
+  bool less(size_t i, size_t j) const {
+    return fitness[i] < fitness[j] ||
+           (fitness[i] == fitness[j] && war_exhaustion[i] < war_exhaustion[j]);
+  }
+
+  /** @brief Sort the rows as sort sorts a vector of castles
+   */
+  void sort();
+
+  /** @brief Get the first worst row, as max_element on a vector of castles
+   *
+   * @return The row index, or 0 if empty
+   */
+  size_t worst() const;
+
+  /** @brief Get the king of a row as a knight
+   *
+   * @param i The row index
+   * @return A knight with the genes of the row
+   */
+  Knight knight(size_t i) const { return Knight(row(i), dimension); }
+
+  /** @brief Exchange the contents of two matrices
+   *
+   * @param other The matrix to swap with
+   */
+  void swap(PopulationMatrix &other);
+};
+
+#endif // __POPULATION_MATRIX_H
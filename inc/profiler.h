@@ -0,0 +1,121 @@
+#ifndef __PROFILER_H
+#define __PROFILER_H
+
+extern "C" {
+#include "../cec17_profile.h"
+}
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+
+using namespace std;
+
+/**
+ * @brief Parts of a CSEA run whose time is measured
+ */
+enum class Phase {
+  Run,        // The whole csea() call
+  Generation, // Crossover and mutation of the new knights
+  Siege,      // Evaluation of the knights and siege of the castles
+  Alliance,   // Alliances between castles
+  Completion, // Completion of the population
+  Count
+};
+
+/**
+ * @brief Opt-in cycle counters of the CSEA phases. Enabling it also enables
+ * the evaluation profiler of cec17_profile.h, so the summary shows how much
+ * of every phase is spent evaluating
+ */
+class Profiler {
+private:
+  static constexpr int num_phases = static_cast<int>(Phase::Count);
+  static atomic<uint64_t> phase_cycles[num_phases];
+  static atomic<unsigned long> phase_calls[num_phases];
+
+public:
+  /** @brief Enable or disable the phase and evaluation counters
+   *
+   * @param active Whether to measure
+   */
+  static void enable(bool active) { cec17_profile_enable(active); }
+
+  /** @brief Whether the counters are enabled
+   *
+   * @return True if enabled
+   */
+  static bool enabled() { return cec17_profile_active != 0; }
+
+  /** @brief Clear the phase and evaluation counters
+   */
+  static void reset();
+
+  /** @brief Account for one execution of a phase
+   *
+   * @param phase The phase
+   * @param cycles Its duration in cycles
+   */
+  static void add(Phase phase, uint64_t cycles) {
+    phase_cycles[static_cast<int>(phase)] += cycles;
+    phase_calls[static_cast<int>(phase)]++;
+  }
+
+  /** @brief Cycles spent in a phase
+   *
+   * @param phase The phase
+   * @return The cycles
+   */
+  static uint64_t cycles(Phase phase) {
+    return phase_cycles[static_cast<int>(phase)];
+  }
+
+  /** @brief Times a phase has been measured
+   *
+   * @param phase The phase
+   * @return The number of executions
+   */
+  static unsigned long calls(Phase phase) {
+    return phase_calls[static_cast<int>(phase)];
+  }
+
+  /** @brief Cycles spent evaluating, for every function and dimension
+   *
+   * @return The cycles
+   */
+  static uint64_t evaluation_cycles();
+
+  /** @brief Write in CSV the time of every phase and of the evaluations, and
+   * their share of the run. The cost of every function is written by
+   * cec17_profile_print
+   *
+   * @param out The stream to write to
+   */
+  static void summary(ostream &out);
+};
+
+/**
+ * @brief Measures a phase from its construction to the end of its scope.
+ * Costs one check when the profiler is disabled
+ */
+class ScopedPhase {
+private:
+  Phase phase;
+  bool active;
+  uint64_t start;
+
+public:
+  explicit ScopedPhase(Phase phase)
+      : phase(phase), active(Profiler::enabled()),
+        start(active ? cec17_cycles() : 0) {}
+
+  ~ScopedPhase() {
+    if (active) {
+      Profiler::add(phase, cec17_cycles() - start);
+    }
+  }
+
+  ScopedPhase(const ScopedPhase &) = delete;
+  ScopedPhase &operator=(const ScopedPhase &) = delete;
+};
+
+#endif // __PROFILER_H
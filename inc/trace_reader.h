@@ -0,0 +1,90 @@
+#ifndef __TRACE_READER_H
+#define __TRACE_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Block of rows of a trace, pointing into the mapped file
+ */
+struct TraceBlock {
+  const int64_t *evaluation; // Number of the evaluation of each row
+  const double *error;       // Best error after that evaluation
+  const int64_t *nanoseconds; // Time since the trace started
+  const int32_t *generation;  // Generation of the algorithm
+  size_t rows;
+};
+
+/**
+ * @brief Rows of one run of a trace
+ */
+struct TraceRun {
+  int funcid;
+  int dimension;
+  long max_evaluations;
+  vector<TraceBlock> blocks;
+  size_t rows; // Rows of all the blocks
+
+  /** @brief Best error after an evaluation with a row in the trace
+   *
+   * @param evaluation The number of the evaluation
+   * @param error Where the error is stored
+   * @return True if the evaluation has a row
+   */
+  bool error_at(long evaluation, double &error) const;
+};
+
+/**
+ * @brief Read-only view of a convergence trace (see cec17_trace.h). The file
+ * is mapped in memory and its columns are used in place
+ */
+class TraceReader {
+private:
+  const unsigned char *data = nullptr;
+  size_t size = 0;
+  vector<TraceRun> trace_runs;
+
+  /** @brief Split the mapped file into runs and blocks
+   *
+   * @return True if the whole file is a valid trace
+   */
+  bool parse();
+
+public:
+  /** @brief Constructor, maps the file
+   *
+   * @param fname The trace file
+   */
+  explicit TraceReader(const string &fname);
+
+  ~TraceReader();
+
+  TraceReader(const TraceReader &) = delete;
+  TraceReader &operator=(const TraceReader &) = delete;
+
+  /** @brief Whether the file has been mapped and is a valid trace
+   *
+   * @return True if it can be read
+   */
+  bool is_open() const { return data != nullptr; }
+
+  /** @brief Get the runs of the trace, in the order they were written
+   *
+   * @return The runs
+   */
+  const vector<TraceRun> &runs() const { return trace_runs; }
+
+  /** @brief Milestone lines of a run, the same that cec17 writes in its
+   * results file (without the header)
+   *
+   * @param run The run
+   * @return The lines, one per milestone found in the trace
+   */
+  static string milestones_csv(const TraceRun &run);
+};
+
+#endif // __TRACE_READER_H
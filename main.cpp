@@ -7,7 +7,7 @@ extern "C" {
 #include <vector>
 
 using namespace std;
-using Random = effolkronium::random_static;
+using Random = effolkronium::random_thread_local;
 
 int main() {
   int seed = 0;
@@ -21,6 +21,8 @@ int main() {
   double sigma = 100.0;
   double epsilon = 1e-6;
   CSEAArgs csea_args(population_size, 0, 0, mutation_rate, sigma, epsilon);
+  // csea_args.target_error = 1e-8; // Uncomment to stop at the optimum
+  // csea_args.ziggurat_mutation = true; // Faster mutation, other numbers
 
   for (auto dim : dims) {
     csea_args.dimension = dim;
@@ -34,6 +36,7 @@ int main() {
         cec17_init("CSEA", funcid, dim);
         // cec17_print_output(); // Comment to print in console, uncomment to
         // print in file
+        // cec17_trace(NULL, 100); // Uncomment to save the convergence trace
 
         Random::seed(seed + i);
         auto result = csea(csea_args);
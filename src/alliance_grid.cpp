@@ -0,0 +1,84 @@
+#ifndef __ALLIANCE_GRID_CPP
+#define __ALLIANCE_GRID_CPP
+
+#include "../inc/alliance_grid.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+void AllianceGrid::cell_of(const double *genes, int64_t *cell) const {
+  for (size_t d = 0; d < grid_dimensions; ++d) {
+    cell[d] = (int64_t)floor(genes[d] / cell_width);
+  }
+}
+
+uint64_t AllianceGrid::hash(const int64_t *cell) const {
+  uint64_t h = 0;
+  for (size_t d = 0; d < grid_dimensions; ++d) {
+    h = (h + (uint64_t)cell[d]) * 0x9E3779B97F4A7C15ull;
+    h ^= h >> 29;
+  }
+  return h;
+}
+
+bool AllianceGrid::build(const PopulationMatrix &population, double epsilon) {
+  grid_dimensions = min(population.get_dimension(), max_grid_dimensions);
+  cells.clear();
+
+  // The division of a gene by the width rounds with a relative error, which
+  // must stay far below a cell for near kings to be in neighbouring cells
+  double scale = 0.0;
+  for (size_t i = 0; i < population.size(); ++i) {
+    for (size_t d = 0; d < grid_dimensions; ++d) {
+      scale = max(scale, fabs(population.row(i)[d]));
+    }
+  }
+  if (!(epsilon > scale * 1e-13) || !isfinite(scale)) {
+    return false;
+  }
+  cell_width = 2.0 * epsilon;
+
+  int64_t cell[max_grid_dimensions];
+  for (size_t i = 0; i < population.size(); ++i) {
+    cell_of(population.row(i), cell);
+    cells.emplace_back(hash(cell), i);
+  }
+  sort(cells.begin(), cells.end());
+  return true;
+}
+
+const vector<size_t> &
+AllianceGrid::candidates(const PopulationMatrix &population, size_t i) const {
+  int64_t cell[max_grid_dimensions], neighbour[max_grid_dimensions];
+  size_t num_neighbours = 1;
+
+  cell_of(population.row(i), cell);
+  for (size_t d = 0; d < grid_dimensions; ++d) {
+    num_neighbours *= 3;
+  }
+
+  found.clear();
+  for (size_t n = 0; n < num_neighbours; ++n) {
+    // The digits of n in base 3 are the offsets of the neighbour
+    size_t digits = n;
+    for (size_t d = 0; d < grid_dimensions; ++d) {
+      neighbour[d] = cell[d] + (int64_t)(digits % 3) - 1;
+      digits /= 3;
+    }
+
+    uint64_t key = hash(neighbour);
+    auto first = lower_bound(cells.begin(), cells.end(), make_pair(key, i + 1));
+    for (auto it = first; it != cells.end() && it->first == key; ++it) {
+      found.push_back(it->second);
+    }
+  }
+
+  // Different cells may share a hash
+  sort(found.begin(), found.end());
+  found.erase(unique(found.begin(), found.end()), found.end());
+  return found;
+}
+
+#endif // __ALLIANCE_GRID_CPP
@@ -5,32 +5,35 @@
 #include "../inc/random.hpp"
 
 using namespace std;
-using Random = effolkronium::random_static;
+using Random = effolkronium::random_thread_local;
 
 bool Castle::siege(const Knight &knight, const double knight_fitness) {
-  // The knight is stronger, so it can take the castle
-  if (knight_fitness < fitness) {
+  if (siege_succeeds(fitness, war_exhaustion, knight_fitness)) {
+    // The knight takes the castle
     king = knight;
     fitness = knight_fitness;
     war_exhaustion = 0; // Reset war exhaustion
     return true;
   }
 
-  // The knight is weaker, check if the castle can withstand the siege
-  double siege_strength = sigmoid(war_exhaustion) * knight_fitness / fitness;
+  // The siege fails, increase war exhaustion
+  war_exhaustion++;
+  return false;
+}
 
-  double p = Random::get<double>(0.0, 1.0);
-  if (p < siege_strength) {
-    // The siege is successful, the knight takes the castle
-    king = knight;
-    fitness = knight_fitness;
-    war_exhaustion = 0; // Reset war exhaustion
+bool Castle::siege_succeeds(double castle_fitness, unsigned int war_exhaustion,
+                            double knight_fitness) {
+  // The knight is stronger, so it can take the castle
+  if (knight_fitness < castle_fitness) {
     return true;
   }
 
-  // The siege fails, increase war exhaustion
-  war_exhaustion++;
-  return false;
+  // The knight is weaker, check if the castle can withstand the siege
+  double siege_strength =
+      sigmoid(war_exhaustion) * knight_fitness / castle_fitness;
+
+  double p = Random::get<double>(0.0, 1.0);
+  return p < siege_strength;
 }
 
 bool Castle::can_ally(const Castle &other, const double epsilon) const {
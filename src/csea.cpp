@@ -4,140 +4,218 @@
 #include "../inc/castle.h"
 #include "../inc/csea.h"
 #include "../inc/knight.h"
+#include "../inc/population_matrix.h"
+#include "../inc/profiler.h"
 #include "../inc/random.hpp"
 #include <iostream>
 #include <vector>
 
 using namespace std;
-using Random = effolkronium::random_static;
+using Random = effolkronium::random_thread_local;
 
 CSEAResult csea(const CSEAArgs &args) {
-  vector<Castle> population =
-      generate_initial_population(args.population_size, args.dimension);
-  sort(population.begin(), population.end());
-  CSEAResult result = {population[0].get_king(), population[0].get_fitness(), 0,
+  if (args.profile) {
+    Profiler::reset();
+    Profiler::enable(true);
+  }
+  uint64_t run_start = args.profile ? cec17_cycles() : 0;
+
+  CSEABuffers buffers(args);
+  PopulationMatrix population = generate_initial_population(
+      args.population_size, args.dimension, buffers.cache);
+  population.sort();
+  CSEAResult result = {population.knight(0), population.fitness_at(0), 0,
                        args.population_size};
 
   // Calculate the upper bound of evaluations in a generation
   int evaluations_upper_bound = get_evaluations_upper_bound(args);
+  unsigned long uncounted_hits = 0; // Cache hits already discounted
 
-  while (result.evaluations + evaluations_upper_bound < args.max_evaluations) {
+  while (result.evaluations + evaluations_upper_bound < args.max_evaluations &&
+         !target_reached(args, result)) {
+    cec17_generation(result.generation);
     cout << "Generation: " << result.generation
          << ", Best Knight Fitness: " << result.fitness
          << ", Evaluations: " << result.evaluations << endl;
 
     // Generate a set of knight from the crossing of the castles
-    vector<Knight> new_knights = generate_new_generation(population, args);
+    generate_new_generation(population, args, buffers);
 
     // For each knight, try to siege the castles
-    siege_castles(population, new_knights, result);
+    siege_castles(population, buffers.knights, result, buffers.cache);
 
     // Form alliances between castles
-    population = form_alliances(population, args.epsilon, result);
+    form_alliances(population, args.epsilon, result, buffers);
 
     // Complete the population with the best knight if not already present
-    complete_population(population, args, result);
+    complete_population(population, args, result, buffers.cache);
+
+    // Cache hits that do not count are not evaluations either
+    if (!args.cache_hits_count) {
+      unsigned long hits = buffers.cache.hits();
+      result.evaluations -= hits - uncounted_hits;
+      uncounted_hits = hits;
+    }
 
     result.generation++;
   }
 
+  // The rest of the budget would not change the error of the milestones
+  if (target_reached(args, result)) {
+    cec17_finish();
+  }
+
+  if (args.profile) {
+    Profiler::add(Phase::Run, cec17_cycles() - run_start);
+    Profiler::enable(false);
+    Profiler::summary(cout);
+    cec17_profile_print(stdout);
+  }
+
   return result;
 }
 
-vector<Castle> generate_initial_population(int population_size, int dimension) {
-  vector<Castle> population;
+PopulationMatrix generate_initial_population(int population_size,
+                                             int dimension,
+                                             FitnessCache &cache) {
+  PopulationMatrix population(dimension, population_size);
   for (int i = 0; i < population_size; ++i) {
-    Knight knight(dimension);
-    double fitness = knight.fitness();
-    population.emplace_back(knight, fitness);
+    Knight::random_genes(population.row(i), dimension);
   }
+
+  Knight::batch_fitness(population.row(0), population_size, dimension,
+                        population.fitness_data(), &cache);
   return population;
 }
 
-vector<Knight> generate_new_generation(const vector<Castle> &population,
-                                       const CSEAArgs &args) {
-  vector<Knight> new_generation;
+void generate_new_generation(const PopulationMatrix &population,
+                             const CSEAArgs &args, CSEABuffers &buffers) {
+  ScopedPhase phase(Phase::Generation);
 
-  // Crossover the castles to get new knights
-  for (int i = 0; i < population.size(); ++i) {
-    for (int j = i + 1; j < population.size(); ++j) {
-      Knight child = population[i].crossover(population[j]);
-      new_generation.push_back(child);
-    }
-  }
+  PopulationMatrix &new_generation = buffers.knights;
+  size_t size = population.size();
+  int dimension = population.get_dimension();
+  new_generation.resize(size * (size - 1) / 2);
 
-  // Mutate some of the knights
-  for (auto &knight : new_generation) {
-    knight.mutate(0.005);
+  // Crossover the castles to get new knights, each castle with all the
+  // castles after it in a single block
+  size_t child = 0;
+  for (size_t i = 0; i + 1 < size; ++i) {
+    size_t count = size - i - 1;
+    Knight::blx_alpha_block(population.row(i), population.row(i + 1), count,
+                            new_generation.row(child), dimension,
+                            buffers.uniforms);
+    child += count;
   }
 
-  return new_generation;
+  // Mutate some of the knights
+  Knight::gaussian_mutation_block(new_generation.row(0), new_generation.size(),
+                                  dimension, 0.005, 100.0,
+                                  args.ziggurat_mutation, buffers.mutation);
 }
 
-void siege_castles(vector<Castle> &population, const vector<Knight> &knights,
-                   CSEAResult &best) {
-  for (const auto &knight : knights) {
-    double knight_fitness = knight.fitness();
+void siege_castles(PopulationMatrix &population, PopulationMatrix &knights,
+                   CSEAResult &best, FitnessCache &cache) {
+  ScopedPhase phase(Phase::Siege);
+
+  // Evaluate the whole generation at once
+  size_t dimension = knights.get_dimension();
+  Knight::batch_fitness(knights.row(0), knights.size(), dimension,
+                        knights.fitness_data(), &cache);
+
+  for (size_t i = 0; i < knights.size(); ++i) {
+    double knight_fitness = knights.fitness_at(i);
     best.evaluations++;
     // Select a castle to siege
     int castle_index = Random::get<int>(0, population.size() - 1);
-    Castle &castle = population[castle_index];
-    bool sieged = castle.siege(knight, knight_fitness);
+    bool sieged = Castle::siege_succeeds(
+        population.fitness_at(castle_index),
+        population.war_exhaustion_at(castle_index), knight_fitness);
+    if (sieged) {
+      population.set_row(castle_index, knights.row(i), knight_fitness);
+    } else {
+      population.war_exhaustion_at(castle_index)++;
+    }
 
     // If the siege was successful, check if the new king is better than the
     // best found so far
     if (sieged && knight_fitness < best.fitness) {
-      best.best_knight = knight;
+      best.best_knight = knights.knight(i);
       best.fitness = knight_fitness;
     }
   }
 }
 
-vector<Castle> form_alliances(const vector<Castle> &population, double epsilon,
-                              CSEAResult &best) {
-  vector<Castle> new_population;
-  vector<bool> allied(population.size(), false);
-  for (int i = 0; i < population.size(); ++i) {
+void form_alliances(PopulationMatrix &population, double epsilon,
+                    CSEAResult &best, CSEABuffers &buffers) {
+  ScopedPhase phase(Phase::Alliance);
+
+  int dimension = population.get_dimension();
+  PopulationMatrix &new_population = buffers.allies;
+  vector<bool> &allied = buffers.allied;
+  new_population.clear();
+  allied.assign(population.size(), false);
+  // Without the grid (a threshold too small for it), every pair is compared
+  bool indexed = buffers.grid.build(population, epsilon);
+  for (size_t i = 0; i < population.size(); ++i) {
     if (allied[i])
       continue; // Skip already allied castles
 
-    const Castle &castle1 = population[i];
-
-    for (int j = i + 1; j < population.size(); ++j) {
+    // Only the castles in the neighbouring cells may be near, and they are
+    // visited in the same order as all of them
+    const vector<size_t> *candidates =
+        indexed ? &buffers.grid.candidates(population, i) : nullptr;
+    size_t num_candidates =
+        indexed ? candidates->size() : population.size() - i - 1;
+    for (size_t c = 0; c < num_candidates; ++c) {
+      size_t j = indexed ? (*candidates)[c] : i + 1 + c;
       if (allied[j])
         continue; // Skip already allied castles
 
-      const Castle &castle2 = population[j];
-
-      if (castle1.can_ally(castle2, epsilon)) {
-        // Form an alliance and create a new castle
-        Castle new_castle = castle1.alliance(castle2);
+      if (Knight::is_near(population.row(i), population.row(j), dimension,
+                          epsilon)) {
+        // Form an alliance and create a new castle, whose king is the cross
+        // of both kings
+        size_t k = new_population.size();
+        new_population.resize(k + 1);
+        Knight::blx_alpha(population.row(i), population.row(j),
+                          new_population.row(k), dimension);
+        new_population.fitness_at(k) =
+            Knight::evaluate(new_population.row(k), dimension, &buffers.cache);
+        new_population.war_exhaustion_at(k) =
+            min(population.war_exhaustion_at(i),
+                population.war_exhaustion_at(j));
         best.evaluations++;
-        new_population.push_back(new_castle);
         allied[i] = true;
         allied[j] = true;
         // Update the best knight if the new king is better
-        if (new_castle.get_fitness() > best.fitness) {
-          best.best_knight = new_castle.get_king();
-          best.fitness = new_castle.get_fitness();
+        if (new_population.fitness_at(k) > best.fitness) {
+          best.best_knight = new_population.knight(k);
+          best.fitness = new_population.fitness_at(k);
         }
       }
     }
     if (!allied[i]) {
       // If no alliance was formed, keep the original castle
-      new_population.push_back(castle1);
+      new_population.push_back(population, i);
     }
   }
 
-  return new_population;
+  // The old population is kept as the buffer of the next alliances
+  population.swap(new_population);
 }
 
-void complete_population(vector<Castle> &population, const CSEAArgs &args,
-                         CSEAResult &best) {
+void complete_population(PopulationMatrix &population, const CSEAArgs &args,
+                         CSEAResult &best, FitnessCache &cache) {
+  ScopedPhase phase(Phase::Completion);
+
+  const size_t target = args.population_size;
+
   // Check if the best knight is already in the population
   bool found_best = false;
-  for (const auto &castle : population) {
-    if (castle.get_king() == best.best_knight) {
+  for (size_t i = 0; i < population.size(); ++i) {
+    if (Knight::is_near(population.row(i), best.best_knight.data(),
+                        args.dimension, numeric_limits<double>::epsilon())) {
       found_best = true;
       break;
     }
@@ -146,21 +224,23 @@ void complete_population(vector<Castle> &population, const CSEAArgs &args,
   // If not found, add it to the population
   if (!found_best) {
     // If population is full, replace the worst castle
-    if (population.size() >= args.population_size) {
-      auto worst_it = max_element(population.begin(), population.end());
-      *worst_it = Castle(best.best_knight, best.fitness);
+    if (population.size() >= target) {
+      population.set_row(population.worst(), best.best_knight.data(),
+                         best.fitness);
     } else {
       // Otherwise, just add the best knight as a new castle
-      population.emplace_back(best.best_knight, best.fitness);
+      population.push_back(best.best_knight.data(), best.fitness);
     }
   }
 
   // Fill the rest of the population with random castles if needed
-  while (population.size() < args.population_size) {
-    Knight knight(args.dimension);
-    double fitness = knight.fitness();
+  while (population.size() < target) {
+    size_t k = population.size();
+    population.resize(k + 1);
+    Knight::random_genes(population.row(k), args.dimension);
+    population.fitness_at(k) =
+        Knight::evaluate(population.row(k), args.dimension, &cache);
     best.evaluations++;
-    population.emplace_back(knight, fitness);
   }
 }
 
@@ -171,4 +251,9 @@ int get_evaluations_upper_bound(const CSEAArgs &args) {
   return evals_from_sieging + evals_from_population_completition;
 }
 
+bool target_reached(const CSEAArgs &args, const CSEAResult &best) {
+  return args.target_error > 0.0 &&
+         cec17_error(best.fitness) < args.target_error;
+}
+
 #endif // __CSEA_CPP
@@ -0,0 +1,103 @@
+#ifndef __FITNESS_CACHE_CPP
+#define __FITNESS_CACHE_CPP
+
+#include "../inc/fitness_cache.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+FitnessCache::FitnessCache(size_t capacity, bool hits_count)
+    : count_hits(hits_count) {
+  if (capacity == 0) {
+    return;
+  }
+
+  size_t slots = 1;
+  while (slots < capacity) {
+    slots <<= 1;
+  }
+  mask = slots - 1;
+  values.resize(slots);
+  hashes.resize(slots, 0);
+}
+
+uint64_t FitnessCache::hash(const double *genes, size_t size) {
+  // FNV-1a over the 64-bit words, then a final mix of the bits
+  uint64_t h = 0xcbf29ce484222325ull;
+  for (size_t i = 0; i < size; ++i) {
+    uint64_t bits;
+    memcpy(&bits, &genes[i], sizeof(bits));
+    h = (h ^ bits) * 0x100000001b3ull;
+  }
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  return h != 0 ? h : 1;
+}
+
+bool FitnessCache::matches(size_t slot, uint64_t key_hash,
+                           const double *genes) const {
+  return hashes[slot] == key_hash &&
+         memcmp(&keys[slot * dimension], genes, dimension * sizeof(double)) ==
+             0;
+}
+
+bool FitnessCache::lookup(const double *genes, size_t size, double &fitness) {
+  if (!enabled() || size != dimension) {
+    miss_count++;
+    return false;
+  }
+
+  uint64_t key_hash = hash(genes, dimension);
+  for (size_t probe = 0; probe < max_probes; ++probe) {
+    size_t slot = (key_hash + probe) & mask;
+    if (hashes[slot] == 0) {
+      break;
+    }
+    if (matches(slot, key_hash, genes)) {
+      fitness = values[slot];
+      hit_count++;
+      return true;
+    }
+  }
+
+  miss_count++;
+  return false;
+}
+
+void FitnessCache::insert(const double *genes, size_t size, double fitness) {
+  if (!enabled()) {
+    return;
+  }
+
+  // The keys are allocated for the dimension of the first chromosome
+  if (size != dimension) {
+    dimension = size;
+    keys.assign(hashes.size() * dimension, 0.0);
+    fill(hashes.begin(), hashes.end(), 0);
+  }
+
+  uint64_t key_hash = hash(genes, dimension);
+  size_t target = key_hash & mask;
+  for (size_t probe = 0; probe < max_probes; ++probe) {
+    size_t slot = (key_hash + probe) & mask;
+    if (hashes[slot] == 0 || matches(slot, key_hash, genes)) {
+      target = slot;
+      break;
+    }
+  }
+
+  hashes[target] = key_hash;
+  values[target] = fitness;
+  copy(genes, genes + dimension, keys.begin() + target * dimension);
+}
+
+void FitnessCache::clear() {
+  fill(hashes.begin(), hashes.end(), 0);
+  hit_count = 0;
+  miss_count = 0;
+}
+
+#endif // __FITNESS_CACHE_CPP
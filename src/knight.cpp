@@ -4,17 +4,23 @@
 #include "../inc/knight.h"
 #include "../inc/random.hpp"
 
+#include <cmath>
+#include <cstdint>
 #include <vector>
 
 using namespace std;
-using Random = effolkronium::random_static;
+using Random = effolkronium::random_thread_local;
 
 Knight::Knight(int dimension, bool randomize, double radius) {
   chromosome.resize(dimension, 0.0);
   if (randomize) {
-    for (int i = 0; i < dimension; ++i) {
-      chromosome[i] = Random::get<double>(-radius, radius);
-    }
+    random_genes(chromosome.data(), dimension, radius);
+  }
+}
+
+void Knight::random_genes(double *genes, int dimension, double radius) {
+  for (int i = 0; i < dimension; ++i) {
+    genes[i] = Random::get<double>(-radius, radius);
   }
 }
 
@@ -22,20 +28,70 @@ Knight Knight::blx_alpha(const Knight &parent1, const Knight &parent2) const {
   int dimension = parent1.chromosome.size();
   Knight child(dimension, false);
 
+  blx_alpha(parent1.chromosome.data(), parent2.chromosome.data(),
+            child.chromosome.data(), dimension);
+  return child;
+}
+
+void Knight::blx_alpha(const double *parent1, const double *parent2,
+                       double *child, int dimension) {
   for (int i = 0; i < dimension; ++i) {
-    double min_val = min(parent1.chromosome[i], parent2.chromosome[i]);
-    double max_val = max(parent1.chromosome[i], parent2.chromosome[i]);
+    double min_val = min(parent1[i], parent2[i]);
+    double max_val = max(parent1[i], parent2[i]);
     double range = max_val - min_val;
     double alpha = Random::get<double>(-0.5 * range, 0.5 * range);
-    child.chromosome[i] = min_val + alpha;
+    child[i] = min_val + alpha;
   }
+}
 
-  return child;
+void Knight::blx_alpha_block(const double *parent1, const double *parents2,
+                             size_t count, double *children, int dimension,
+                             vector<double> &uniforms) {
+  uniforms.resize(count * dimension);
+  uniform_block(uniforms.data(), uniforms.size());
+
+  for (size_t c = 0; c < count; ++c) {
+    const double *parent2 = parents2 + c * dimension;
+    const double *u = uniforms.data() + c * dimension;
+    double *child = children + c * dimension;
+
+    // The same operations as Random::get<double>(-0.5 * range, 0.5 * range)
+    // (a null range gives 0 either way), with no dependency between genes
+    for (int i = 0; i < dimension; ++i) {
+      double min_val = min(parent1[i], parent2[i]);
+      double max_val = max(parent1[i], parent2[i]);
+      double range = max_val - min_val;
+      double from = -0.5 * range, to = 0.5 * range;
+      child[i] = min_val + (u[i] * (to - from) + from);
+    }
+  }
+}
+
+void Knight::uniform_block(double *values, size_t n) {
+  static_assert(Random::min() == 0 && Random::max() == UINT32_MAX,
+                "uniform_block expects an engine of 32 bits");
+  auto &engine = Random::engine();
+
+  for (size_t k = 0; k < n; ++k) {
+    uint32_t low = engine();
+    uint32_t high = engine();
+    values[k] = (double)low + (double)high * 4294967296.0;
+  }
+  // As generate_canonical: divide by 2^64 and keep the result below 1
+  for (size_t k = 0; k < n; ++k) {
+    values[k] /= 18446744073709551616.0;
+    if (values[k] >= 1.0) {
+      values[k] = nextafter(1.0, 0.0);
+    }
+  }
 }
 
 void Knight::gaussian_mutation(double mutation_rate, double sigma) {
-  int dimension = chromosome.size();
+  gaussian_mutation(chromosome.data(), chromosome.size(), mutation_rate, sigma);
+}
 
+void Knight::gaussian_mutation(double *chromosome, int dimension,
+                               double mutation_rate, double sigma) {
   // Calculate the number of genes to mutate based on the mutation rate
   int fixed_mutations = static_cast<int>(dimension * mutation_rate);
   double optional_mutation = dimension * mutation_rate - fixed_mutations;
@@ -57,4 +113,122 @@ void Knight::gaussian_mutation(double mutation_rate, double sigma) {
   }
 }
 
+void Knight::gaussian_mutation_block(double *chromosomes, size_t count,
+                                     int dimension, double mutation_rate,
+                                     double sigma, bool ziggurat,
+                                     MutationBuffers &buffers) {
+  if (!ziggurat) {
+    for (size_t r = 0; r < count; ++r) {
+      gaussian_mutation(chromosomes + r * dimension, dimension, mutation_rate,
+                        sigma);
+    }
+    return;
+  }
+
+  static const ZigguratNormal normal; // Only read once built
+  vector<int> &counts = buffers.counts, &indices = buffers.indices;
+  vector<double> &values = buffers.values;
+  auto &engine = Random::engine();
+
+  // The number of mutations of every row: as in gaussian_mutation, one more
+  // with probability 1/2 if the rate asks for a fraction of a gene
+  int fixed_mutations = static_cast<int>(dimension * mutation_rate);
+  bool optional_mutation = dimension * mutation_rate - fixed_mutations > 0.0;
+  size_t total = 0;
+  counts.resize(count);
+  indices.reserve(count * (fixed_mutations + 1)); // Enough for any block
+  values.reserve(count * (fixed_mutations + 1));
+  for (size_t r = 0; r < count; ++r) {
+    counts[r] = fixed_mutations + (optional_mutation && engine() >> 31 ? 1 : 0);
+    total += counts[r];
+  }
+
+  // Their genes, without bias (Lemire's method), and their values
+  uint32_t range = dimension;
+  uint32_t threshold = -range % range;
+  indices.resize(total);
+  for (size_t k = 0; k < total; ++k) {
+    uint64_t m = (uint64_t)engine() * range;
+    while ((uint32_t)m < threshold) {
+      m = (uint64_t)engine() * range;
+    }
+    indices[k] = m >> 32;
+  }
+  values.resize(total);
+  normal.fill(engine, values.data(), total, sigma);
+
+  size_t k = 0;
+  for (size_t r = 0; r < count; ++r) {
+    double *chromosome = chromosomes + r * dimension;
+    for (int i = 0; i < counts[r]; ++i, ++k) {
+      double &gene = chromosome[indices[k]];
+      gene = min(100.0, max(-100.0, gene + values[k]));
+    }
+  }
+}
+
+double Knight::evaluate(const double *genes, int dimension,
+                        FitnessCache *cache) {
+  double fitness;
+  if (cache != nullptr && cache->enabled() &&
+      cache->lookup(genes, dimension, fitness)) {
+    record_cache_hit(*cache, fitness);
+  } else {
+    fitness = cec17_fitness(const_cast<double *>(genes));
+    if (cache != nullptr) {
+      cache->insert(genes, dimension, fitness);
+    }
+  }
+  check_bounds(genes, dimension);
+  return fitness;
+}
+
+vector<double> Knight::batch_fitness(const vector<Knight> &knights) {
+  vector<double> fitness(knights.size());
+  if (knights.empty()) {
+    return fitness;
+  }
+
+  // Copy the chromosomes into a row-major matrix
+  size_t dimension = knights[0].chromosome.size();
+  vector<double> matrix(knights.size() * dimension);
+  for (size_t i = 0; i < knights.size(); ++i) {
+    copy(knights[i].chromosome.begin(), knights[i].chromosome.end(),
+         matrix.begin() + i * dimension);
+  }
+
+  batch_fitness(matrix.data(), knights.size(), dimension, fitness.data());
+  return fitness;
+}
+
+void Knight::batch_fitness(const double *matrix, size_t rows, size_t dimension,
+                           double *fitness, FitnessCache *cache) {
+  bool cached_run = cache != nullptr && cache->enabled();
+  size_t first = 0; // First row not evaluated yet
+  for (size_t i = 0; i < rows; ++i) {
+    const double *genes = matrix + i * dimension;
+    check_bounds(genes, dimension);
+
+    // On a hit, the previous rows are evaluated first so that the knights are
+    // still recorded in order
+    double cached;
+    if (cached_run && cache->lookup(genes, dimension, cached)) {
+      cec17_fitness_batch(matrix + first * dimension, fitness + first,
+                          i - first);
+      record_cache_hit(*cache, cached);
+      fitness[i] = cached;
+      first = i + 1;
+    }
+  }
+
+  cec17_fitness_batch(matrix + first * dimension, fitness + first,
+                      rows - first);
+
+  if (cached_run) {
+    for (size_t i = 0; i < rows; ++i) {
+      cache->insert(matrix + i * dimension, dimension, fitness[i]);
+    }
+  }
+}
+
 #endif // __KNIGHT_CPP
@@ -0,0 +1,71 @@
+#ifndef __POPULATION_MATRIX_CPP
+#define __POPULATION_MATRIX_CPP
+
+#include "../inc/population_matrix.h"
+
+#include <algorithm>
+#include <numeric>
+
+using namespace std;
+
+void PopulationMatrix::reserve(size_t rows) {
+  genes.reserve(rows * dimension);
+  fitness.reserve(rows);
+  war_exhaustion.reserve(rows);
+}
+
+void PopulationMatrix::resize(size_t rows) {
+  genes.resize(rows * dimension);
+  fitness.resize(rows);
+  war_exhaustion.resize(rows);
+}
+
+void PopulationMatrix::push_back(const double *row_genes, double row_fitness,
+                                 unsigned int row_war_exhaustion) {
+  genes.insert(genes.end(), row_genes, row_genes + dimension);
+  fitness.push_back(row_fitness);
+  war_exhaustion.push_back(row_war_exhaustion);
+}
+
+void PopulationMatrix::set_row(size_t i, const double *row_genes,
+                               double row_fitness,
+                               unsigned int row_war_exhaustion) {
+  copy(row_genes, row_genes + dimension, row(i));
+  fitness[i] = row_fitness;
+  war_exhaustion[i] = row_war_exhaustion;
+}
+
+void PopulationMatrix::sort() {
+  // std::sort makes the same comparisons on the indices as on the castles, so
+  // even equal castles end up in the same order
+  vector<size_t> order(size());
+  iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [this](size_t i, size_t j) { return less(i, j); });
+
+  PopulationMatrix sorted(dimension);
+  sorted.reserve(size());
+  for (size_t i : order) {
+    sorted.push_back(*this, i);
+  }
+  swap(sorted);
+}
+
+size_t PopulationMatrix::worst() const {
+  size_t worst = 0;
+  for (size_t i = 1; i < size(); ++i) {
+    if (less(worst, i)) {
+      worst = i;
+    }
+  }
+  return worst;
+}
+
+void PopulationMatrix::swap(PopulationMatrix &other) {
+  std::swap(dimension, other.dimension);
+  genes.swap(other.genes);
+  fitness.swap(other.fitness);
+  war_exhaustion.swap(other.war_exhaustion);
+}
+
+#endif // __POPULATION_MATRIX_CPP
@@ -0,0 +1,59 @@
+#ifndef __PROFILER_CPP
+#define __PROFILER_CPP
+
+#include "../inc/profiler.h"
+
+#include <iomanip>
+
+using namespace std;
+
+atomic<uint64_t> Profiler::phase_cycles[Profiler::num_phases];
+atomic<unsigned long> Profiler::phase_calls[Profiler::num_phases];
+
+static const char *phase_names[] = {"run", "generation", "siege", "alliance",
+                                    "completion"};
+
+void Profiler::reset() {
+  for (int i = 0; i < num_phases; ++i) {
+    phase_cycles[i] = 0;
+    phase_calls[i] = 0;
+  }
+  cec17_profile_reset();
+}
+
+uint64_t Profiler::evaluation_cycles() {
+  static const int dimensions[] = {2, 5, 10, 20, 30, 50, 100};
+  cec17_profile_stats stats;
+  uint64_t total = 0;
+
+  for (int funcid = 1; funcid <= 30; ++funcid) {
+    for (int dim : dimensions) {
+      if (cec17_profile_get(funcid, dim, &stats)) {
+        total += stats.cycles;
+      }
+    }
+  }
+  return total;
+}
+
+void Profiler::summary(ostream &out) {
+  double per_ns = cec17_profile_cycles_per_ns();
+  uint64_t run = cycles(Phase::Run);
+  uint64_t evaluation = evaluation_cycles();
+
+  out << "phase,calls,cycles,ms,share" << endl;
+  for (int i = 0; i < num_phases; ++i) {
+    out << phase_names[i] << "," << phase_calls[i] << "," << phase_cycles[i]
+        << "," << fixed << setprecision(3) << phase_cycles[i] / per_ns / 1e6
+        << "," << setprecision(4)
+        << (run > 0 ? (double)phase_cycles[i] / run : 0.0) << endl;
+  }
+  // Evaluations happen inside the phases (mostly the siege)
+  out << "evaluation,," << evaluation << "," << setprecision(3)
+      << evaluation / per_ns / 1e6 << "," << setprecision(4)
+      << (run > 0 ? (double)evaluation / run : 0.0) << endl;
+  out.unsetf(ios::floatfield);
+  out << setprecision(6);
+}
+
+#endif // __PROFILER_CPP
@@ -0,0 +1,130 @@
+#ifndef __TRACE_READER_CPP
+#define __TRACE_READER_CPP
+
+#include "../inc/trace_reader.h"
+
+extern "C" {
+#include "../cec17_trace.h"
+}
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Milestones of cec17.c, in percentage of the evaluations
+static const int ratios[] = {1,  2,  3,  5,  10, 20, 30,
+                             40, 50, 60, 70, 80, 90, 100};
+
+bool TraceRun::error_at(long evaluation, double &error) const {
+  for (const TraceBlock &block : blocks) {
+    for (size_t i = 0; i < block.rows; ++i) {
+      if (block.evaluation[i] == evaluation) {
+        error = block.error[i];
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+TraceReader::TraceReader(const string &fname) {
+  struct stat info;
+  int fd = open(fname.c_str(), O_RDONLY);
+
+  if (fd < 0) {
+    cerr << "Error, it cannot be possible to open the trace '" << fname << "'"
+         << endl;
+    return;
+  }
+  if (fstat(fd, &info) == 0 && info.st_size > 0) {
+    void *mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped != MAP_FAILED) {
+      data = static_cast<const unsigned char *>(mapped);
+      size = info.st_size;
+    }
+  }
+  close(fd);
+
+  if (data != nullptr && !parse()) {
+    cerr << "Error, '" << fname << "' is not a valid trace" << endl;
+    munmap(const_cast<unsigned char *>(data), size);
+    data = nullptr;
+    trace_runs.clear();
+  }
+}
+
+TraceReader::~TraceReader() {
+  if (data != nullptr) {
+    munmap(const_cast<unsigned char *>(data), size);
+  }
+}
+
+bool TraceReader::parse() {
+  size_t offset = 0;
+
+  while (offset < size) {
+    if (size - offset >= sizeof(cec17_trace_header) &&
+        memcmp(data + offset, CEC17_TRACE_MAGIC, 8) == 0) {
+      cec17_trace_header header;
+      memcpy(&header, data + offset, sizeof(header));
+      if (header.version != CEC17_TRACE_VERSION) {
+        return false;
+      }
+      trace_runs.push_back({header.funcid, header.dimension,
+                            (long)header.max_evals, {}, 0});
+      offset += sizeof(header);
+      continue;
+    }
+
+    // Every block belongs to the last run started before it
+    cec17_trace_block block;
+    if (trace_runs.empty() || size - offset < sizeof(block)) {
+      return false;
+    }
+    memcpy(&block, data + offset, sizeof(block));
+    size_t rows = block.rows;
+    size_t bytes = sizeof(block) + rows * 28 + (rows % 2) * 4;
+    if (memcmp(block.tag, CEC17_TRACE_ROWS, 4) != 0 || block.rows < 0 ||
+        size - offset < bytes) {
+      return false;
+    }
+
+    // The header and the 8-byte columns keep the 8-byte alignment of the
+    // mapping, so the columns are used in place
+    const unsigned char *column = data + offset + sizeof(block);
+    TraceBlock view;
+    view.evaluation = reinterpret_cast<const int64_t *>(column);
+    view.error = reinterpret_cast<const double *>(column + rows * 8);
+    view.nanoseconds = reinterpret_cast<const int64_t *>(column + rows * 16);
+    view.generation = reinterpret_cast<const int32_t *>(column + rows * 24);
+    view.rows = rows;
+    trace_runs.back().blocks.push_back(view);
+    trace_runs.back().rows += rows;
+    offset += bytes;
+  }
+  return true;
+}
+
+string TraceReader::milestones_csv(const TraceRun &run) {
+  string csv;
+  char line[128];
+  double error;
+
+  for (int ratio : ratios) {
+    // First evaluation whose percentage reaches the milestone
+    long evaluation = (ratio * run.max_evaluations + 99) / 100;
+    if (run.error_at(evaluation, error)) {
+      snprintf(line, sizeof(line), "%d,%d,%ld,%e\n", run.funcid, run.dimension,
+               evaluation * 100 / run.max_evaluations, error);
+      csv += line;
+    }
+  }
+  return csv;
+}
+
+#endif // __TRACE_READER_CPP
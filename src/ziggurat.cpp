@@ -0,0 +1,52 @@
+#ifndef __ZIGGURAT_CPP
+#define __ZIGGURAT_CPP
+
+#include "../inc/ziggurat.h"
+
+using namespace std;
+
+ZigguratNormal::ZigguratNormal() {
+  // Every layer has the same area: the rectangles of the upper layers, and
+  // the base, which is a rectangle up to tail_start plus the tail
+  double f = exp(-0.5 * tail_start * tail_start);
+  edge[0] = layer_area / f;
+  edge[1] = tail_start;
+  edge[layers] = 0.0;
+  for (int i = 2; i < layers; ++i) {
+    edge[i] = sqrt(-2.0 * log(layer_area / edge[i - 1] + f));
+    f = exp(-0.5 * edge[i] * edge[i]);
+  }
+  for (int i = 0; i < layers; ++i) {
+    ratio[i] = edge[i + 1] / edge[i];
+  }
+}
+
+double ZigguratNormal::outside(mt19937 &engine, double u, int layer) const {
+  if (layer == 0) {
+    // The tail, by the method of Marsaglia
+    double x, y;
+    do {
+      x = log(uniform(engine)) / tail_start;
+      y = log(uniform(engine));
+    } while (-2.0 * y < x * x);
+    return u < 0.0 ? x - tail_start : tail_start - x;
+  }
+
+  // The wedge between the rectangle of the layer and the density
+  double x = u * edge[layer];
+  double f0 = exp(-0.5 * (edge[layer] * edge[layer] - x * x));
+  double f1 = exp(-0.5 * (edge[layer + 1] * edge[layer + 1] - x * x));
+  if (f1 + uniform(engine) * (f0 - f1) < 1.0) {
+    return x;
+  }
+  return NAN;
+}
+
+void ZigguratNormal::fill(mt19937 &engine, double *values, size_t n,
+                          double sigma) const {
+  for (size_t k = 0; k < n; ++k) {
+    values[k] = (*this)(engine) * sigma;
+  }
+}
+
+#endif // __ZIGGURAT_CPP
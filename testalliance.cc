@@ -0,0 +1,91 @@
+#include "inc/alliance_grid.h"
+#include "inc/knight.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Test of the alliance grid: for every castle, the castles after it that are
+ * near it must all be candidates, so that form_alliances finds the same
+ * alliances as comparing every pair. The populations mix random kings with
+ * clusters of near and almost near kings, some on the edges of the cells.
+ */
+
+static int errors = 0;
+
+static void check(bool condition, const string &message) {
+  if (!condition) {
+    cerr << message << endl;
+    errors++;
+  }
+}
+
+int main() {
+  mt19937 gen(3);
+  uniform_real_distribution<> position(-100.0, 100.0), offset(-1.0, 1.0);
+
+  for (int dim : {2, 10, 30}) {
+    for (double epsilon : {1e-6, 0.5, 30.0}) {
+      string name = "D" + to_string(dim) + " eps " + to_string(epsilon) + ": ";
+      PopulationMatrix population(dim);
+      vector<double> king(dim);
+
+      for (int i = 0; i < 1000; ++i) {
+        // A new king, or one near (or a bit further than) a previous one
+        if (i < 100 || i % 3 == 0) {
+          for (double &gene : king) {
+            gene = position(gen);
+          }
+        } else {
+          const double *other = population.row(gen() % population.size());
+          for (int d = 0; d < dim; ++d) {
+            king[d] = other[d] + offset(gen) * epsilon * (i % 2 ? 1.0 : 1.2);
+          }
+          if (i % 5 == 0) {
+            king[0] = other[0] + epsilon; // Exactly at the threshold
+          }
+        }
+        population.push_back(king.data(), 0.0);
+      }
+
+      AllianceGrid grid;
+      check(grid.build(population, epsilon), name + "grid not built");
+      size_t pairs = 0, candidates = 0;
+      for (size_t i = 0; i < population.size() && errors == 0; ++i) {
+        const vector<size_t> &found = grid.candidates(population, i);
+        size_t c = 0;
+        candidates += found.size();
+        for (size_t j = i + 1; j < population.size(); ++j) {
+          if (!Knight::is_near(population.row(i), population.row(j), dim,
+                               epsilon)) {
+            continue;
+          }
+          pairs++;
+          while (c < found.size() && found[c] < j) {
+            c++;
+          }
+          check(c < found.size() && found[c] == j,
+                name + "near castle not found");
+        }
+        check(is_sorted(found.begin(), found.end()) &&
+                  (found.empty() || found[0] > i),
+              name + "candidates out of order");
+      }
+      cout << name << pairs << " near pairs, " << candidates << " candidates"
+           << endl;
+    }
+  }
+
+  // Too small a threshold for the cells: every pair must be compared
+  PopulationMatrix population(10, 4);
+  AllianceGrid grid;
+  check(!grid.build(population, 0.0), "Grid built without a threshold");
+
+  cout << (errors == 0 ? "OK" : "FAILED") << endl;
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,62 @@
+extern "C" {
+#include "cec17_test_func.h"
+}
+#include "heap_allocs.h"
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+int main() {
+  int dims[] = {10, 30, 50, 100};
+  int num_solutions = 20;
+  int errors = 0;
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<> dis(-100.0, 100.0);
+
+  for (int dim : dims) {
+    vector<double> sol(num_solutions * dim);
+    vector<double> fitness(num_solutions);
+
+    for (auto &value : sol) {
+      value = dis(gen);
+    }
+
+    for (int funcid = 1; funcid <= 30; funcid++) {
+      cec17_context *ctx = cec17_context_create(funcid, dim);
+
+      if (ctx == NULL) {
+        continue;
+      }
+
+      unsigned long allocations = cec17_context_allocations(ctx);
+#if defined(__GLIBC__)
+      unsigned long before = heap_allocs;
+#endif
+
+      // One by one and in blocks, to go through every path of the kernels
+      for (int i = 0; i < num_solutions; i++) {
+        cec17_context_evaluate(ctx, &sol[i * dim], &fitness[i], 1);
+      }
+      cec17_context_evaluate(ctx, &sol[0], &fitness[0], num_solutions);
+
+      bool ok = cec17_context_allocations(ctx) == allocations;
+#if defined(__GLIBC__)
+      ok = ok && heap_allocs == before;
+#endif
+
+      if (!ok) {
+        cerr << "F" << funcid << " D" << dim
+             << ": allocations while evaluating" << endl;
+        errors++;
+      }
+
+      cec17_context_destroy(ctx);
+    }
+  }
+
+  cout << (errors == 0 ? "OK" : "FAILED") << endl;
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
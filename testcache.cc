@@ -0,0 +1,73 @@
+#include "inc/fitness_cache.h"
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Test of the fitness cache: chromosomes are found only when bitwise equal,
+ * the counters follow the lookups and the number of entries stays bounded.
+ */
+
+static int errors = 0;
+
+static void check(bool condition, const char *message) {
+  if (!condition) {
+    cerr << message << endl;
+    errors++;
+  }
+}
+
+int main() {
+  const int dimension = 10;
+  const size_t capacity = 64;
+  FitnessCache cache(capacity);
+  vector<double> chromosome(dimension, 1.5);
+  double fitness = 0.0;
+
+  check(cache.enabled(), "The cache is not enabled");
+  check(!cache.lookup(chromosome, fitness), "Hit in an empty cache");
+  cache.insert(chromosome, 42.0);
+  check(cache.lookup(chromosome, fitness) && fitness == 42.0,
+        "Inserted chromosome not found");
+
+  // 0.0 and -0.0 are equal values but different keys
+  vector<double> zero(dimension, 0.0), negative_zero(dimension, 0.0);
+  negative_zero[3] = -0.0;
+  cache.insert(zero, 1.0);
+  check(!cache.lookup(negative_zero, fitness), "The key is not bitwise");
+
+  // Updating a chromosome replaces its fitness
+  cache.insert(chromosome, 7.0);
+  check(cache.lookup(chromosome, fitness) && fitness == 7.0,
+        "Fitness not updated");
+  check(cache.hits() == 2 && cache.misses() == 2, "Wrong counters");
+
+  // Many more chromosomes than the capacity: at most capacity are found
+  size_t found = 0;
+  for (int i = 0; i < 1000; ++i) {
+    vector<double> key(dimension, i);
+    cache.insert(key, i);
+  }
+  for (int i = 0; i < 1000; ++i) {
+    vector<double> key(dimension, i);
+    if (cache.lookup(key, fitness)) {
+      check(fitness == i, "Wrong fitness for a key");
+      found++;
+    }
+  }
+  check(found > 0 && found <= capacity, "The cache is not bounded");
+
+  cache.clear();
+  check(!cache.lookup(chromosome, fitness), "Hit after clear");
+  check(cache.hits() == 0 && cache.misses() == 1, "Counters not reset");
+
+  FitnessCache disabled;
+  disabled.insert(chromosome, 1.0);
+  check(!disabled.enabled() && !disabled.lookup(chromosome, fitness),
+        "Hit in a disabled cache");
+
+  cout << (errors == 0 ? "OK" : "FAILED") << endl;
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
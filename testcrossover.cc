@@ -0,0 +1,66 @@
+#include "inc/knight.h"
+#include "inc/random.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using Random = effolkronium::random_thread_local;
+
+/**
+ * Test of the block crossover: crossing a castle with the castles after it
+ * in one block gives bitwise the same children as crossing them one by one,
+ * and leaves the random engine in the same state. Some genes are shared by
+ * both parents, so their range is null.
+ */
+
+int main() {
+  const int population_size = 12;
+  int errors = 0;
+
+  for (int dim : {2, 10, 30, 100}) {
+    vector<double> population(population_size * dim);
+    int rows = population_size * (population_size - 1) / 2;
+    vector<double> serial(rows * dim), block(rows * dim), uniforms;
+
+    Random::seed(dim);
+    for (int i = 0; i < population_size; ++i) {
+      Knight::random_genes(&population[i * dim], dim);
+    }
+    for (int i = 0; i < dim; i += 3) {
+      population[dim + i] = population[i];
+    }
+
+    Random::seed(42);
+    int child = 0;
+    for (int i = 0; i < population_size; ++i) {
+      for (int j = i + 1; j < population_size; ++j) {
+        Knight::blx_alpha(&population[i * dim], &population[j * dim],
+                          &serial[child++ * dim], dim);
+      }
+    }
+    auto engine = Random::get_engine();
+
+    Random::seed(42);
+    child = 0;
+    for (int i = 0; i + 1 < population_size; ++i) {
+      size_t count = population_size - i - 1;
+      Knight::blx_alpha_block(&population[i * dim], &population[(i + 1) * dim],
+                              count, &block[child * dim], dim, uniforms);
+      child += count;
+    }
+
+    if (memcmp(serial.data(), block.data(), serial.size() * sizeof(double))) {
+      cerr << "D" << dim << ": different children" << endl;
+      errors++;
+    }
+    if (!Random::is_equal(engine)) {
+      cerr << "D" << dim << ": different random numbers drawn" << endl;
+      errors++;
+    }
+  }
+
+  cout << (errors == 0 ? "OK" : "FAILED") << endl;
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
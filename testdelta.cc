@@ -0,0 +1,122 @@
+extern "C" {
+#include "cec17.h"
+#include "cec17_test_func.h"
+}
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Test of the evaluation states: a chain of sparse updates with
+ * cec17_context_evaluate_delta, some of them repeating a gene and some
+ * changing none, must give the fitness of a full evaluation of each
+ * solution. Functions 7 and 21-30 have no state and must be evaluated in
+ * full. cec17_fitness_state and cec17_fitness_delta must give the same values
+ * as the context.
+ */
+
+static const int dimensions[] = {10, 30};
+static const int updates = 32; // Rebuild period advised in cec17_test_func.h
+
+static int errors = 0;
+
+static void check(bool condition, const string &message) {
+  if (!condition) {
+    cerr << message << endl;
+    errors++;
+  }
+}
+
+static uint64_t xorshift(uint64_t &state) {
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+static double random_gene(uint64_t &state) {
+  double unit = (double)(xorshift(state) >> 11) / 9007199254740992.0;
+  return (2.0 * unit - 1.0) * 100.0;
+}
+
+static bool same(double a, double b) {
+  return fabs(a - b) <= 1e-12 * fabs(b);
+}
+
+int main() {
+  uint64_t state = 0x9E3779B97F4A7C15ull;
+
+  for (int nx : dimensions) {
+    for (int funcid = 1; funcid <= 30; funcid++) {
+      string name = "F" + to_string(funcid) + " D" + to_string(nx) + ": ";
+      cec17_context *ctx = cec17_context_create(funcid, nx);
+      if (ctx == NULL) {
+        continue;
+      }
+
+      int size = cec17_context_state_size(ctx);
+      bool stateless = funcid == 7 || funcid > 20;
+      check(size == (stateless ? 0 : 2 * nx), name + "wrong state size");
+
+      vector<double> x(nx), eval_state(size);
+      vector<int> changed(3);
+      double fitness, full;
+      for (double &gene : x) {
+        gene = random_gene(state);
+      }
+      cec17_context_evaluate_state(ctx, x.data(), &fitness, eval_state.data());
+      cec17_context_evaluate(ctx, x.data(), &full, 1);
+      check(fitness == full, name + "state evaluation differs");
+
+      for (int k = 0; k < updates; k++) {
+        int count = k % 4; // Every fourth update changes nothing
+        for (int j = 0; j < count; j++) {
+          changed[j] = j == 2 ? changed[0] : (int)(xorshift(state) % nx);
+          x[changed[j]] = random_gene(state);
+        }
+        cec17_context_evaluate_delta(ctx, x.data(), &fitness, eval_state.data(),
+                                     changed.data(), count);
+        cec17_context_evaluate(ctx, x.data(), &full, 1);
+        check(stateless ? fitness == full : same(fitness, full),
+              name + "delta evaluation differs after " + to_string(k + 1) +
+                  " updates");
+      }
+      cec17_context_destroy(ctx);
+    }
+  }
+
+  // The functions of cec17.h evaluate on the context of the current run
+  mkdir("results_testdelta", 0755);
+  for (int funcid : {1, 7}) {
+    string name = "cec17 F" + to_string(funcid) + ": ";
+    cec17_context *ctx = cec17_context_create(funcid, 10);
+    cec17_init("testdelta", funcid, 10);
+    check(cec17_state_size() == cec17_context_state_size(ctx),
+          name + "wrong state size");
+
+    vector<double> x(10), eval_state(cec17_state_size());
+    double fitness;
+    int gene = 3;
+    for (double &value : x) {
+      value = random_gene(state);
+    }
+    cec17_context_evaluate(ctx, x.data(), &fitness, 1);
+    check(cec17_fitness_state(x.data(), eval_state.data()) == fitness,
+          name + "state evaluation differs");
+    x[gene] = random_gene(state);
+    cec17_context_evaluate(ctx, x.data(), &fitness, 1);
+    check(same(cec17_fitness_delta(x.data(), eval_state.data(), &gene, 1),
+               fitness),
+          name + "delta evaluation differs");
+    cec17_context_destroy(ctx);
+  }
+
+  cout << (errors == 0 ? "OK" : "FAILED") << endl;
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
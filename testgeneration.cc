@@ -0,0 +1,76 @@
+#include "heap_allocs.h"
+#include "inc/csea.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+/**
+ * Test of the generation pipeline of csea(): once the first generation has
+ * sized the buffers, the generations reuse them and do not allocate, while
+ * the population keeps its size.
+ */
+
+int main() {
+  const int generations = 10;
+  int errors = 0;
+
+  mkdir("results_testgeneration", 0755);
+  for (int dim : {10, 30}) {
+    CSEAArgs args(20, dim, 1000000);
+    unlink(("results_testgeneration/results_1_" + to_string(dim) + ".txt")
+               .c_str());
+    cec17_init("testgeneration", 1, dim);
+
+    CSEABuffers buffers(args);
+    PopulationMatrix population = generate_initial_population(
+        args.population_size, args.dimension, buffers.cache);
+    population.sort();
+    CSEAResult result = {population.knight(0), population.fitness_at(0), 0,
+                         args.population_size};
+
+#if defined(__GLIBC__)
+    unsigned long before = 0;
+#endif
+    for (int g = 0; g <= generations; ++g) {
+#if defined(__GLIBC__)
+      if (g == 1) {
+        before = heap_allocs; // The first generation sizes the buffers
+      }
+#endif
+      generate_new_generation(population, args, buffers);
+      // The crossover may leave the bounds, which the evaluation rejects
+      PopulationMatrix &knights = buffers.knights;
+      for (size_t k = 0; k < knights.size() * dim; ++k) {
+        double &gene = knights.row(0)[k];
+        gene = min(100.0, max(-100.0, gene));
+      }
+      siege_castles(population, knights, result, buffers.cache);
+      form_alliances(population, args.epsilon, result, buffers);
+      complete_population(population, args, result, buffers.cache);
+      result.generation++;
+
+      if ((int)population.size() != args.population_size) {
+        cerr << "D" << dim << ": wrong population size" << endl;
+        errors++;
+        break;
+      }
+    }
+
+#if defined(__GLIBC__)
+    double allocs = (double)(heap_allocs - before) / generations;
+    cout << "D" << dim << ": " << allocs << " allocations per generation"
+         << endl;
+    if (allocs != 0) {
+      errors++;
+    }
+#endif
+  }
+
+  cout << (errors == 0 ? "OK" : "FAILED") << endl;
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,104 @@
+extern "C" {
+#include "cec17_archive.h"
+}
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Test of the hybrid functions (F11-F20) in every dimension: rotating with the
+ * matrix given by the loader, whose rows are already shuffled, must give the
+ * same values, bit by bit, as rotating with the matrix of input_data and then
+ * shuffling the result as the original implementation did. The dimensions
+ * without data in input_data are skipped.
+ */
+
+static const int dimensions[] = {10, 20, 30, 50, 100};
+
+// Reads count values of a text file of input_data
+template <class T>
+static bool read_text(const char *filename, const char *format, T *data,
+                      int count) {
+  FILE *file = fopen(filename, "r");
+  bool ok = file != NULL;
+
+  for (int i = 0; ok && i < count; i++) {
+    ok = fscanf(file, format, &data[i]) == 1;
+  }
+
+  if (file != NULL) {
+    fclose(file);
+  }
+  return ok;
+}
+
+// Same summation order as rotatefunc
+static void rotate(const double *x, double *xrot, int nx, const double *M) {
+  for (int i = 0; i < nx; i++) {
+    xrot[i] = 0;
+    for (int j = 0; j < nx; j++) {
+      xrot[i] = xrot[i] + x[j] * M[i * nx + j];
+    }
+  }
+}
+
+int main() {
+  uint64_t state = 0x9E3779B97F4A7C15ull;
+  int errors = 0;
+
+  for (int funcid = 11; funcid <= 20; funcid++) {
+    for (int nx : dimensions) {
+      vector<double> raw(nx * nx), x(nx), z(nx), y(nx);
+      vector<int> shuffle(nx);
+      double *M = NULL, *OShift = NULL;
+      int *SS = NULL;
+      char filename[64];
+
+      if (!cec17_data_available(funcid, nx)) {
+        continue;
+      }
+
+      sprintf(filename, "input_data/M_%d_D%d.txt", funcid, nx);
+      bool ok = read_text(filename, "%lf", raw.data(), nx * nx);
+      sprintf(filename, "input_data/shuffle_data_%d_D%d.txt", funcid, nx);
+      ok = ok && read_text(filename, "%d", shuffle.data(), nx);
+
+      if (!ok || !cec17_load_text(funcid, nx, &M, &OShift, &SS)) {
+        cerr << "F" << funcid << " D" << nx << ": no data" << endl;
+        errors++;
+        continue;
+      }
+
+      for (int i = 0; i < nx; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        x[i] = (2.0 * (double)(state >> 11) / 9007199254740992.0 - 1.0) * 100.0;
+      }
+
+      rotate(x.data(), z.data(), nx, raw.data());
+      rotate(x.data(), y.data(), nx, M);
+
+      for (int i = 0; i < nx; i++) {
+        if (memcmp(&y[i], &z[shuffle[i] - 1], sizeof(double)) != 0) {
+          cerr << "F" << funcid << " D" << nx << ": gene " << i
+               << " is not the shuffled one" << endl;
+          errors++;
+          break;
+        }
+      }
+
+      free(M);
+      free(OShift);
+      free(SS);
+    }
+  }
+
+  cout << (errors == 0 ? "OK" : "FAILED") << endl;
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
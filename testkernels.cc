@@ -0,0 +1,265 @@
+extern "C" {
+#include "cec17_test_func.h"
+}
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Regression test of the CEC17 kernels: the fitness of a few fixed points in
+ * every function and dimension must be the same as the one given by the
+ * original implementation (compiled without optimizations). Optionally, the
+ * maximum allowed distance in ulps can be given as argument, since compiler
+ * optimizations can change the last bit of some operations.
+ */
+
+#define NUM_POINTS 3
+
+struct Reference {
+  int funcid;
+  int dim;
+  double fitness[NUM_POINTS];
+};
+
+static const Reference references[] = {
+    {1, 2, {0x1.90e54e02c1fa9p+34, 0x1.c07b1c996faefp+33, 0x1.bc8eb24758cdcp+32}},
+    {2, 2, {0x1.4c3p+13, 0x1.d2ep+12, 0x1.e6p+8}},
+    {3, 2, {0x1.d056a85804801p+23, 0x1.386795a6993a6p+10, 0x1.50ac707276f7fp+22}},
+    {4, 2, {0x1.1892014e300b9p+10, 0x1.beaba5683bd54p+9, 0x1.dd3ecc1ccd0e6p+8}},
+    {5, 2, {0x1.0f6d9ae399e8bp+9, 0x1.2080e279f663ap+9, 0x1.0098ebf59154ep+9}},
+    {6, 2, {0x1.5c42259ef1a7ep+9, 0x1.5a3f643193386p+9, 0x1.cb001e200aff5p+9}},
+    {7, 2, {0x1.7b122cdee20e2p+9, 0x1.74ee7085460c2p+9, 0x1.61c9020ae50bdp+9}},
+    {8, 2, {0x1.93b6ed93ed933p+9, 0x1.a4b1fa80e84fdp+9, 0x1.98d08460462c2p+9}},
+    {9, 2, {0x1.f05c22cb3765fp+12, 0x1.0b815c2927e56p+10, 0x1.036eedd27cbd8p+10}},
+    {10, 2, {0x1.9911f6c2dd85cp+10, 0x1.0cb841e701dbbp+11, 0x1.0e0054581b872p+11}},
+    {23, 2, {0x1.42247f74fe86bp+11, 0x1.3aa2ae3dc5c9ep+11, 0x1.7ce8d2865ce1fp+11}},
+    {24, 2, {0x1.6fdba003d6ebbp+11, 0x1.a7bf368f569a3p+11, 0x1.3d45e2bb0bdf2p+11}},
+    {25, 2, {0x1.e70059ef18042p+11, 0x1.7dc848cb7a3f6p+11, 0x1.f20b9b2165f39p+11}},
+    {26, 2, {0x1.79bb906cf4346p+11, 0x1.98b171c62585ep+11, 0x1.81ab60c11fabap+11}},
+    {27, 2, {0x1.22b509a7741dcp+12, 0x1.085cc3470a316p+12, 0x1.d1dd2c421beb2p+11}},
+    {28, 2, {0x1.8de3c9b2a7947p+11, 0x1.9bede000c3f01p+11, 0x1.9ccf5c3c30cbp+11}},
+    {1, 10, {0x1.0d0c221dd653fp+36, 0x1.47c43322dd0bep+36, 0x1.bffa2371f65bep+34}},
+    {2, 10, {0x1.dec6cfd2c0b6p+70, 0x1.85308e945ff7ap+71, 0x1.7bafdb3ea4ed1p+59}},
+    {3, 10, {0x1.361bca1a18352p+33, 0x1.30d25d099045dp+39, 0x1.a11fb163c2d97p+21}},
+    {4, 10, {0x1.a16ce19ad5e9bp+14, 0x1.ef291ac3caefp+16, 0x1.76ebbd75fc5c2p+12}},
+    {5, 10, {0x1.ca804ea589958p+9, 0x1.0a70b1f9e6464p+10, 0x1.6c6b91bab205cp+9}},
+    {6, 10, {0x1.9aee1c53f4bddp+9, 0x1.b84f041dccdf4p+9, 0x1.7437e51a708cfp+9}},
+    {7, 10, {0x1.19f33671d66efp+11, 0x1.e00e37c19d004p+10, 0x1.d5e65f91188cap+9}},
+    {8, 10, {0x1.12a3402ba0d6ap+10, 0x1.1714979be603bp+10, 0x1.d82e404a7f1c2p+9}},
+    {9, 10, {0x1.44529ddeeb5eap+13, 0x1.745268a6d2a4fp+14, 0x1.510ef4ab772b9p+12}},
+    {10, 10, {0x1.452f2df0603ddp+12, 0x1.21ad93d1d2254p+12, 0x1.8106e823de056p+12}},
+    {11, 10, {0x1.97933f304c6a7p+28, 0x1.590752937276p+30, 0x1.fc2926e73af2fp+25}},
+    {12, 10, {0x1.0fe9f154d181dp+34, 0x1.373d6347d5301p+33, 0x1.5554514a5746p+32}},
+    {13, 10, {0x1.d27bc409eac59p+32, 0x1.2b5d70d83089bp+31, 0x1.4fa5f25ff39e2p+31}},
+    {14, 10, {0x1.fbd69b28e0c6ep+31, 0x1.f4631d5f9da2p+24, 0x1.0ddbf7547c1bcp+31}},
+    {15, 10, {0x1.5327af19bfaf3p+34, 0x1.0d6f07a3cc5b2p+29, 0x1.9eabef96d1428p+29}},
+    {16, 10, {0x1.111094d56c582p+15, 0x1.bfcb7bf146cb7p+12, 0x1.abd65067fdedcp+11}},
+    {17, 10, {0x1.cfbe4b5b1ed28p+13, 0x1.f4069f2d5246p+18, 0x1.9425cded34f88p+11}},
+    {18, 10, {0x1.a3990856374cdp+33, 0x1.afb14e124b2ecp+34, 0x1.a6e77228e4d8cp+33}},
+    {19, 10, {0x1.9812f8325790bp+34, 0x1.c76c9001d08efp+34, 0x1.694d430483a6ap+33}},
+    {20, 10, {0x1.a9f2bd541d914p+11, 0x1.6889d8be34ddep+11, 0x1.884c508854741p+11}},
+    {21, 10, {0x1.7b67375b48db6p+11, 0x1.3753d50e81721p+11, 0x1.61a1e930781c2p+11}},
+    {22, 10, {0x1.8d3985da051bfp+12, 0x1.9b148d25d29fap+12, 0x1.4eed8957e7b43p+12}},
+    {23, 10, {0x1.cb04733916d28p+11, 0x1.fb8f674345eeep+11, 0x1.0a8e63bf68c2ep+12}},
+    {24, 10, {0x1.8aedd6ac0a762p+11, 0x1.420e019af0f62p+12, 0x1.a8022d58e1cbap+11}},
+    {25, 10, {0x1.a4804a03ec0c7p+13, 0x1.bb85ba024e153p+13, 0x1.2c806e74f7968p+12}},
+    {26, 10, {0x1.5e34865a7ff96p+12, 0x1.f5d9cd4a8b6ep+12, 0x1.64bd8a9e0e88cp+12}},
+    {27, 10, {0x1.4c907e3dea4f7p+12, 0x1.6b120f39ad41ep+13, 0x1.3b7222627725ep+12}},
+    {28, 10, {0x1.c9e7dd5a41a46p+12, 0x1.36ad74f42dd54p+12, 0x1.1b73ba8f06512p+12}},
+    {29, 10, {0x1.49e3f716af17cp+15, 0x1.5c0c9652502fbp+12, 0x1.6fdbd8f9f2342p+15}},
+    {30, 10, {0x1.1e5fd464df8f2p+32, 0x1.0d0912fb5f90dp+34, 0x1.e30d330831f25p+28}},
+    {1, 20, {0x1.db7b0a58adea8p+36, 0x1.a6a622d2f6922p+36, 0x1.7eefc873b5b57p+35}},
+    {2, 20, {0x1.bb318572654aap+142, 0x1.ae9c8cdf425c6p+141, 0x1.c67b0a3d58666p+124}},
+    {3, 20, {0x1.47b50825043efp+30, 0x1.5e22e607387c9p+37, 0x1.30a5b73be4e23p+41}},
+    {4, 20, {0x1.7f9dc4b879935p+12, 0x1.8f048199ad56ep+15, 0x1.dbb94e947e67dp+13}},
+    {5, 20, {0x1.4a3e962b2273ep+10, 0x1.4296d791b63cap+10, 0x1.bb395cde4c664p+9}},
+    {6, 20, {0x1.ac5b6a76c29dp+9, 0x1.b1d9e012d1bfp+9, 0x1.7cbfba08e7bb3p+9}},
+    {7, 20, {0x1.da63d9cf8bc9ep+11, 0x1.4c7e26b3a5d1p+11, 0x1.3140704290265p+10}},
+    {8, 20, {0x1.4a49a26403f02p+10, 0x1.2c622b2c2cce3p+10, 0x1.174742838878p+10}},
+    {9, 20, {0x1.743f6c401ae5ep+14, 0x1.28bb3b509df4cp+15, 0x1.f496809f11a26p+12}},
+    {10, 20, {0x1.0f82e0b2e2918p+13, 0x1.1da85437fc928p+13, 0x1.35545eceb14dp+13}},
+    {20, 20, {0x1.e0dc716fa37fep+11, 0x1.dbfb54a562631p+11, 0x1.bf1dbf7c9d46ep+11}},
+    {21, 20, {0x1.2243caaed229cp+12, 0x1.b6b182ffec315p+11, 0x1.e503f776cb5fcp+11}},
+    {22, 20, {0x1.4f8d442e471dbp+13, 0x1.7a2de111e1a7ep+13, 0x1.32f9ff096cf9fp+13}},
+    {23, 20, {0x1.c1e760cfafb52p+12, 0x1.505e6b9a5e2b3p+12, 0x1.6c256d5461313p+12}},
+    {24, 20, {0x1.3780783ed3d92p+12, 0x1.d5ea80c2c1b5ap+11, 0x1.1e3f46bfefdfcp+12}},
+    {25, 20, {0x1.4f02c8699b3d9p+15, 0x1.5a5dbb6ed5c4dp+15, 0x1.67f5d60d45a43p+13}},
+    {26, 20, {0x1.50ef470ff391bp+14, 0x1.81c311a2a16bp+14, 0x1.4c8daf57f3ca6p+13}},
+    {27, 20, {0x1.ded465c51a2c8p+12, 0x1.aed874bdeb592p+12, 0x1.26c50c2852a88p+13}},
+    {28, 20, {0x1.09070d24653dep+14, 0x1.597c8d90ce71cp+13, 0x1.6e396255facd1p+12}},
+    {1, 30, {0x1.76f5853cd8952p+37, 0x1.a6b04b3a5d00ap+37, 0x1.39a05d77aa7afp+36}},
+    {2, 30, {0x1.b1c0386305cc5p+204, 0x1.952544991fa42p+189, 0x1.fce88e7b0d2bfp+203}},
+    {3, 30, {0x1.3bbd54de67367p+49, 0x1.2153509ff4fc1p+47, 0x1.08f0e0aeda084p+29}},
+    {4, 30, {0x1.b0457ebc358f3p+16, 0x1.78f67d22ff5ecp+17, 0x1.13c487660ef61p+15}},
+    {5, 30, {0x1.8b1fd5464e0eap+10, 0x1.81efb62aad4c5p+10, 0x1.19999e5f00f4dp+10}},
+    {6, 30, {0x1.916ed09c56b34p+9, 0x1.7ab659fd7802cp+9, 0x1.713665c69f592p+9}},
+    {7, 30, {0x1.80c6fa74f02f1p+12, 0x1.1f8c1eedd0eap+12, 0x1.9a0895f132509p+10}},
+    {8, 30, {0x1.94e5652b7ce78p+10, 0x1.e721b9a335587p+10, 0x1.4c63ce4bfbap+10}},
+    {9, 30, {0x1.5544d81805a6ap+17, 0x1.4a6bf71f20107p+16, 0x1.324713588de9bp+15}},
+    {10, 30, {0x1.83c60e1f1fa4ep+13, 0x1.b2081695a9fa2p+13, 0x1.5c2d729248c47p+13}},
+    {11, 30, {0x1.09a509cc19a7ep+22, 0x1.70e4a4cde384p+37, 0x1.2f642277deadfp+29}},
+    {12, 30, {0x1.a1be3529270e2p+35, 0x1.08c789b667bccp+36, 0x1.b9690213da558p+34}},
+    {13, 30, {0x1.6b916866c31ccp+37, 0x1.2f6b0a693994ep+36, 0x1.4f51484f558f7p+35}},
+    {14, 30, {0x1.c10846738c148p+32, 0x1.33d7518de9fb2p+32, 0x1.3726b29f5f039p+30}},
+    {15, 30, {0x1.32db3eff39c9ep+36, 0x1.3afa7a5872f9p+35, 0x1.8e7722a7e73a1p+32}},
+    {16, 30, {0x1.45a20c6ebfb01p+16, 0x1.e2da71eca4bb4p+15, 0x1.aedffde4bf9cep+14}},
+    {17, 30, {0x1.3dd783f6a33f3p+24, 0x1.0ba8618f4a3c3p+25, 0x1.2191f4be9e6fdp+18}},
+    {18, 30, {0x1.682a0d15a60f1p+33, 0x1.87742a8bdd4acp+31, 0x1.25fbca6bab784p+32}},
+    {19, 30, {0x1.2e46a059d80cep+35, 0x1.41b619bc84f05p+35, 0x1.8cdaecc46341ap+32}},
+    {20, 30, {0x1.593f01d6c6a6ep+12, 0x1.1001839ae7bd7p+12, 0x1.55009314475c4p+12}},
+    {21, 30, {0x1.92050d7015df8p+11, 0x1.e40e45bd46e35p+11, 0x1.95f5b83e853c7p+11}},
+    {22, 30, {0x1.887087f5032a1p+13, 0x1.a936c6fb2a8ebp+13, 0x1.9fc9069a2ccbcp+13}},
+    {23, 30, {0x1.297b16bd04e41p+12, 0x1.3e136aa8668f2p+12, 0x1.f8ce15e352a54p+12}},
+    {24, 30, {0x1.7a57451026c8p+12, 0x1.881bf2f010fcfp+12, 0x1.44bd0c4de10abp+12}},
+    {25, 30, {0x1.26e49b9036cf9p+16, 0x1.749148f57b119p+14, 0x1.20d22781c18f7p+13}},
+    {26, 30, {0x1.8b1bce10c3e8dp+15, 0x1.4622e433290bcp+15, 0x1.fe00b2185fb6bp+13}},
+    {27, 30, {0x1.bb78575203e59p+13, 0x1.bbbcf7360301dp+13, 0x1.4b171b08c011ep+13}},
+    {28, 30, {0x1.685ae8cc780a1p+14, 0x1.4216dcc63e521p+14, 0x1.3cf6dcac9228ep+13}},
+    {29, 30, {0x1.dd959714fff7bp+25, 0x1.195d206b3306ep+24, 0x1.ad7b915a3034bp+17}},
+    {30, 30, {0x1.fe16cc7832484p+34, 0x1.96361040b6d92p+34, 0x1.2e3f0406023a2p+33}},
+    {1, 50, {0x1.757677c330327p+38, 0x1.a11a713a183bap+38, 0x1.fc6e93093a5fep+36}},
+    {2, 50, {0x1.fd5863c3eb04dp+366, 0x1.d70356cc8a484p+361, 0x1.452eb847e93p+292}},
+    {3, 50, {0x1.0815e15058cbap+39, 0x1.828c4655c7044p+38, 0x1.6d6def87cff2dp+47}},
+    {4, 50, {0x1.58cd7839221fcp+18, 0x1.e31e715dcac3fp+17, 0x1.c2e8ef340a4cap+15}},
+    {5, 50, {0x1.e91911517676ep+10, 0x1.e444832dbfaeap+10, 0x1.54419a146e727p+10}},
+    {6, 50, {0x1.86b47e92be5cbp+9, 0x1.95a6d525b2431p+9, 0x1.7413eba21a59cp+9}},
+    {7, 50, {0x1.6a46ad8e51acap+12, 0x1.02f70ca2ec59ap+13, 0x1.133597b08f71ep+11}},
+    {8, 50, {0x1.092414084a06ep+11, 0x1.193369a80611fp+11, 0x1.b26b6790954a6p+10}},
+    {9, 50, {0x1.cbb6988d7465p+17, 0x1.3c5dcc1a10f99p+17, 0x1.0ca3af2b9b7dfp+16}},
+    {10, 50, {0x1.647d5818acf9ap+14, 0x1.49794f273e9bfp+14, 0x1.5222a6fbba5eep+14}},
+    {11, 50, {0x1.221332f6c23d7p+35, 0x1.6eafacfdddc4fp+37, 0x1.e1bbf07fd8a3dp+20}},
+    {12, 50, {0x1.7c8bd586a7634p+38, 0x1.6027c6d00b288p+38, 0x1.0b6a3f0cea9a8p+37}},
+    {13, 50, {0x1.65264ae3871d9p+37, 0x1.2cd7839045c14p+38, 0x1.adad44276834dp+36}},
+    {14, 50, {0x1.767accd06e157p+30, 0x1.11fda9eaec71fp+30, 0x1.5c3364f2032d9p+30}},
+    {15, 50, {0x1.a6042bb59ce4ap+36, 0x1.25c738373bc8fp+37, 0x1.65653710360efp+34}},
+    {16, 50, {0x1.c931a8cbd0ae6p+15, 0x1.1cb39afa60d77p+16, 0x1.83ee41961a60dp+14}},
+    {17, 50, {0x1.f9e60e974bb12p+28, 0x1.de30766948545p+26, 0x1.5fb2ebf721deap+17}},
+    {18, 50, {0x1.37790a445e7e4p+33, 0x1.c1710623f5d86p+32, 0x1.027f4df9953f5p+31}},
+    {19, 50, {0x1.60bc3016a0cdp+35, 0x1.387209b546b0dp+35, 0x1.9a91aed0056ddp+33}},
+    {20, 50, {0x1.04c38bdc8c81dp+13, 0x1.a79420c90b9e5p+12, 0x1.5c1c93d119bedp+12}},
+    {21, 50, {0x1.29754272a63cbp+12, 0x1.11b8c858b89p+12, 0x1.10dc51c29f4aep+12}},
+    {22, 50, {0x1.6c2b910f095d6p+14, 0x1.48c3f744d67cp+14, 0x1.53d4e40130015p+14}},
+    {23, 50, {0x1.5a916ac253b3p+13, 0x1.419750bfc14ecp+13, 0x1.2e5af31ce33eep+13}},
+    {24, 50, {0x1.3becca2e14eb5p+13, 0x1.3ffda8e7ca366p+13, 0x1.ac7532e360022p+12}},
+    {25, 50, {0x1.3aa129de48251p+17, 0x1.84e62e003b424p+16, 0x1.36ad33b44673bp+14}},
+    {26, 50, {0x1.dc27c3f62bc4ep+16, 0x1.9ac6b80e4c5b6p+15, 0x1.3dc3089b1fed4p+14}},
+    {27, 50, {0x1.77bffc2ee6c7fp+13, 0x1.63bea4cb53cb2p+13, 0x1.2ce44714cf20cp+14}},
+    {28, 50, {0x1.04672dbd16d68p+15, 0x1.6d9cc7f9b340ap+15, 0x1.3bdd0da62547p+14}},
+    {29, 50, {0x1.0869251852faap+30, 0x1.47e08e41b92bp+27, 0x1.a533ae6cd0001p+22}},
+    {30, 50, {0x1.c196f437b3634p+34, 0x1.9050c741c3ee8p+36, 0x1.7e1702d20a252p+34}},
+    {1, 100, {0x1.bcfe43e4f9c7p+39, 0x1.984fddbc57fbp+39, 0x1.16a15297ed557p+38}},
+    {2, 100, {0x1.051e0580178c6p+763, 0x1.e17714377bd23p+750, 0x1.261c176ff4683p+636}},
+    {3, 100, {0x1.688e0ce18569ap+52, 0x1.3b0e8aa7b93bep+51, 0x1.b72ab6a59f303p+46}},
+    {4, 100, {0x1.43a6026f943bcp+19, 0x1.a761fe4572c32p+18, 0x1.370cf0e391a0dp+17}},
+    {5, 100, {0x1.e407020beb185p+11, 0x1.d052c4e71a3d6p+11, 0x1.28ff44f277666p+11}},
+    {6, 100, {0x1.8ec5059d6951cp+9, 0x1.9368077ed681p+9, 0x1.6f060b61fb5e8p+9}},
+    {7, 100, {0x1.fdde4084cecd5p+13, 0x1.daa8bd0891acep+13, 0x1.1132ce2777478p+12}},
+    {8, 100, {0x1.13033bc60b52p+12, 0x1.014aab46d9685p+12, 0x1.64917e7861846p+11}},
+    {9, 100, {0x1.493944752e39ep+18, 0x1.78b8307ba74d5p+18, 0x1.d564fec61cbbep+16}},
+    {10, 100, {0x1.37856c78bdd6ap+15, 0x1.44b098fbd5117p+15, 0x1.1dfb028c604e5p+15}},
+    {11, 100, {0x1.3c9fb06e36f4cp+46, 0x1.9a6f19bb4812p+41, 0x1.83043cec7fd78p+44}},
+    {12, 100, {0x1.3b4befa07bcd1p+39, 0x1.50547ba495772p+39, 0x1.e5ee1eccc0a26p+37}},
+    {13, 100, {0x1.ac371f846e849p+36, 0x1.1c7570f734d43p+37, 0x1.ec528a5102cf6p+35}},
+    {14, 100, {0x1.f7abaefe5756bp+31, 0x1.80c77ee017722p+32, 0x1.652bac51cdf25p+30}},
+    {15, 100, {0x1.0aff947b89d09p+37, 0x1.0ceb518052113p+37, 0x1.3500be11d43a9p+35}},
+    {16, 100, {0x1.1ac9b821e74cbp+16, 0x1.0b82c2a73578bp+16, 0x1.30598ac4b1fefp+15}},
+    {17, 100, {0x1.7a269e94d7c7ep+29, 0x1.0549c606fc2c7p+31, 0x1.5c6ef11df1157p+27}},
+    {18, 100, {0x1.03a1575516d15p+34, 0x1.3247435bb1be9p+33, 0x1.745dd20c30e78p+30}},
+    {19, 100, {0x1.9657b6977d97ap+36, 0x1.8ac40523881bdp+36, 0x1.33f296e1ad743p+35}},
+    {20, 100, {0x1.b80f08f04e37dp+13, 0x1.796620b134dd3p+13, 0x1.621c07f83959ap+13}},
+    {21, 100, {0x1.f788f63260f4bp+12, 0x1.52d102735ff12p+13, 0x1.59c228e1281a1p+13}},
+    {22, 100, {0x1.6830d9d14e20fp+15, 0x1.44b37a4c67278p+15, 0x1.3d72acf5a2e8bp+15}},
+    {23, 100, {0x1.9ba1c6c6b4239p+13, 0x1.7aae8f88b5186p+13, 0x1.0093409f113bep+14}},
+    {24, 100, {0x1.6e64fb6251acbp+14, 0x1.05c447f7d7869p+14, 0x1.057d1c63343e2p+14}},
+    {25, 100, {0x1.a0e7105bb7d96p+17, 0x1.fe625af552d1bp+18, 0x1.178cf26810d53p+15}},
+    {26, 100, {0x1.c91ca4c1d7f26p+17, 0x1.f21783f83dd03p+16, 0x1.0309274fc30f8p+16}},
+    {27, 100, {0x1.ec3a2623da8bfp+14, 0x1.a5d19a5b7b667p+14, 0x1.9508594d0e34dp+14}},
+    {28, 100, {0x1.b170fb0789b0dp+16, 0x1.fb1c852e91386p+16, 0x1.51fccd4d4c85ap+15}},
+    {29, 100, {0x1.4a4d5a49ef605p+31, 0x1.002b1f095fbbp+31, 0x1.1a974ed471e97p+23}},
+    {30, 100, {0x1.0858ef90ae142p+37, 0x1.54f356715d332p+37, 0x1.c7caaacd4c551p+35}},
+};
+
+// Points of the regression test, deterministic for each function and dimension
+static void test_points(int funcid, int dim, vector<double> &sol) {
+  uint64_t state = 0x9E3779B97F4A7C15ull ^ (uint64_t)(funcid * 1000 + dim);
+
+  for (size_t i = 0; i < sol.size(); i++) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    double unit = (double)(state >> 11) / 9007199254740992.0;
+    // The last point is close to the optimum, the other ones anywhere
+    double range = (i / dim == NUM_POINTS - 1) ? 1.0 : 100.0;
+    sol[i] = (2.0 * unit - 1.0) * range;
+  }
+}
+
+// Distance in ulps between two doubles
+static uint64_t ulps(double a, double b) {
+  int64_t ia, ib;
+
+  if (std::isnan(a) || std::isnan(b)) {
+    return (std::isnan(a) && std::isnan(b)) ? 0 : UINT64_MAX;
+  }
+
+  memcpy(&ia, &a, sizeof(ia));
+  memcpy(&ib, &b, sizeof(ib));
+  ia = ia < 0 ? INT64_MIN - ia : ia;
+  ib = ib < 0 ? INT64_MIN - ib : ib;
+  return ia > ib ? (uint64_t)ia - (uint64_t)ib : (uint64_t)ib - (uint64_t)ia;
+}
+
+int main(int argc, char *argv[]) {
+  uint64_t max_ulps = argc > 1 ? strtoull(argv[1], NULL, 10) : 0;
+  int errors = 0;
+
+  for (const Reference &ref : references) {
+    cec17_context *ctx = cec17_context_create(ref.funcid, ref.dim);
+    vector<double> sol(NUM_POINTS * ref.dim);
+    vector<double> fitness(NUM_POINTS);
+
+    if (ctx == NULL) {
+      cerr << "F" << ref.funcid << " D" << ref.dim << ": no data" << endl;
+      errors++;
+      continue;
+    }
+
+    // The vectorised kernels are not bit-exact, see testsimd
+    cec17_context_set_flags(ctx, 0);
+    test_points(ref.funcid, ref.dim, sol);
+
+    // One by one and as a block, the results must be the same
+    for (int i = 0; i < NUM_POINTS; i++) {
+      cec17_context_evaluate(ctx, &sol[i * ref.dim], &fitness[i], 1);
+    }
+
+    for (int i = 0; i < NUM_POINTS; i++) {
+      if (ulps(fitness[i], ref.fitness[i]) > max_ulps) {
+        cerr.precision(17);
+        cerr << "F" << ref.funcid << " D" << ref.dim << " point " << i << ": "
+             << fitness[i] << " instead of " << ref.fitness[i] << endl;
+        errors++;
+      }
+    }
+
+    cec17_context_evaluate(ctx, &sol[0], &fitness[0], NUM_POINTS);
+
+    for (int i = 0; i < NUM_POINTS; i++) {
+      if (ulps(fitness[i], ref.fitness[i]) > max_ulps) {
+        cerr << "F" << ref.funcid << " D" << ref.dim << " point " << i
+             << ": different result in a block" << endl;
+        errors++;
+      }
+    }
+
+    cec17_context_destroy(ctx);
+  }
+
+  cout << (errors == 0 ? "OK" : "FAILED") << endl;
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
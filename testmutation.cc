@@ -0,0 +1,99 @@
+#include "inc/knight.h"
+#include "inc/random.hpp"
+#include "inc/ziggurat.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using Random = effolkronium::random_thread_local;
+
+/**
+ * Test of the block mutation: without the Ziggurat sampler it mutates as
+ * gaussian_mutation row by row, and with it every row changes as many genes
+ * as the rate asks for, which stay in bounds. The Ziggurat numbers must have
+ * the moments and the tail of the standard normal distribution.
+ */
+
+static int errors = 0;
+
+static void check(bool condition, const string &message) {
+  if (!condition) {
+    cerr << message << endl;
+    errors++;
+  }
+}
+
+int main() {
+  const size_t rows = 2000;
+
+  for (int dim : {10, 30, 100}) {
+    string name = "D" + to_string(dim) + ": ";
+    vector<double> original(rows * dim), serial, block;
+    MutationBuffers buffers;
+
+    Random::seed(dim);
+    for (size_t r = 0; r < rows; ++r) {
+      Knight::random_genes(&original[r * dim], dim);
+    }
+
+    serial = original;
+    Random::seed(42);
+    for (size_t r = 0; r < rows; ++r) {
+      Knight::gaussian_mutation(&serial[r * dim], dim, 0.05, 100.0);
+    }
+    auto engine = Random::get_engine();
+
+    block = original;
+    Random::seed(42);
+    Knight::gaussian_mutation_block(block.data(), rows, dim, 0.05, 100.0,
+                                    false, buffers);
+    check(serial == block && Random::is_equal(engine),
+          name + "different mutation than gaussian_mutation");
+
+    block = original;
+    Knight::gaussian_mutation_block(block.data(), rows, dim, 0.05, 100.0,
+                                    true, buffers);
+    size_t fixed = (size_t)(dim * 0.05), total = 0;
+    bool optional = dim * 0.05 > fixed;
+    for (size_t r = 0; r < rows && errors == 0; ++r) {
+      size_t changed = 0;
+      for (int i = 0; i < dim; ++i) {
+        double gene = block[r * dim + i];
+        changed += gene != original[r * dim + i];
+        check(fabs(gene) <= 100.0, name + "gene out of bounds");
+      }
+      check(changed <= fixed + optional, name + "too many mutations");
+      total += changed;
+    }
+    // Half of the rows get the optional mutation; a gene mutated twice
+    // counts once
+    double expected = rows * (fixed + 0.5 * optional);
+    check(total > 0.9 * expected && total <= rows * (fixed + optional),
+          name + "wrong number of mutations");
+  }
+
+  ZigguratNormal normal;
+  mt19937 engine(7);
+  const long n = 4000000;
+  double sum = 0.0, sum2 = 0.0, sum4 = 0.0;
+  long tail = 0;
+  for (long k = 0; k < n; ++k) {
+    double x = normal(engine);
+    sum += x;
+    sum2 += x * x;
+    sum4 += x * x * x * x;
+    tail += fabs(x) > 3.0;
+  }
+  // Around five standard errors of each estimate
+  check(fabs(sum / n) < 0.0025, "Ziggurat: wrong mean");
+  check(fabs(sum2 / n - 1.0) < 0.0036, "Ziggurat: wrong variance");
+  check(fabs(sum4 / n - 3.0) < 0.025, "Ziggurat: wrong kurtosis");
+  check(fabs((double)tail / n - 0.0026998) < 0.00013,
+        "Ziggurat: wrong tail");
+
+  cout << (errors == 0 ? "OK" : "FAILED") << endl;
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,61 @@
+extern "C" {
+#include "cec17_test_func.h"
+}
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Test of the parallel batches of cec17_test_func: with several threads (if
+ * the library is built with CEC17_OPENMP) every batch must give the same
+ * fitness, bit by bit and in the same order, as evaluating it serially.
+ * Batch sizes around the grain check both the serial and the parallel paths.
+ */
+
+static const int functions[] = {1, 5, 7, 11, 20, 21, 26, 30};
+static const int dimensions[] = {10, 30, 100};
+static const int batches[] = {1, 15, 16, 17, 63, 200};
+
+int main() {
+  uint64_t state = 0x9E3779B97F4A7C15ull;
+  int threads = cec17_set_threads(4);
+  int errors = 0;
+
+  cec17_set_grain(8);
+  cout << "Threads: " << threads << endl;
+
+  for (int funcid : functions) {
+    for (int nx : dimensions) {
+      for (int mx : batches) {
+        vector<double> x(mx * nx), serial(mx), parallel(mx);
+
+        for (double &value : x) {
+          state ^= state << 13;
+          state ^= state >> 7;
+          state ^= state << 17;
+          value = (2.0 * (double)(state >> 11) / 9007199254740992.0 - 1.0) *
+                  100.0;
+        }
+
+        cec17_set_threads(1);
+        cec17_test_func(x.data(), serial.data(), nx, mx, funcid);
+        cec17_set_threads(threads);
+        cec17_test_func(x.data(), parallel.data(), nx, mx, funcid);
+
+        if (memcmp(serial.data(), parallel.data(), mx * sizeof(double)) != 0) {
+          cerr << "F" << funcid << " D" << nx << " batch " << mx
+               << ": different results" << endl;
+          errors++;
+        }
+      }
+    }
+  }
+
+  cec17_set_threads(1);
+  cout << (errors == 0 ? "OK" : "FAILED") << endl;
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
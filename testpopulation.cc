@@ -0,0 +1,86 @@
+#include "inc/population_matrix.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Test of the population matrix: its rows are aligned to a cache line, and
+ * sort and worst give the same castles as sort and max_element on the vector
+ * of castles they replace, ties included.
+ */
+
+static int errors = 0;
+
+static void check(bool condition, const char *message) {
+  if (!condition) {
+    cerr << message << endl;
+    errors++;
+  }
+}
+
+struct Row {
+  double fitness;
+  unsigned int war_exhaustion;
+  int id;
+
+  bool operator<(const Row &other) const {
+    return fitness < other.fitness ||
+           (fitness == other.fitness && war_exhaustion < other.war_exhaustion);
+  }
+};
+
+int main() {
+  const size_t dimension = 10, rows = 40;
+  PopulationMatrix population(dimension);
+  vector<Row> castles;
+
+  for (size_t i = 0; i < rows; ++i) {
+    vector<double> genes(dimension, (double)i);
+    double fitness = (double)((i * 7) % 5); // Many ties
+    unsigned int war_exhaustion = (i * 3) % 2;
+    population.push_back(genes.data(), fitness, war_exhaustion);
+    castles.push_back({fitness, war_exhaustion, (int)i});
+  }
+
+  check(population.size() == rows, "Wrong number of rows");
+  check(reinterpret_cast<uintptr_t>(population.row(0)) % 64 == 0,
+        "The rows are not aligned");
+
+  size_t worst = population.worst();
+  int expected = max_element(castles.begin(), castles.end())->id;
+  check(population.row(worst)[0] == expected, "Wrong worst castle");
+
+  population.sort();
+  sort(castles.begin(), castles.end());
+  for (size_t i = 0; i < rows; ++i) {
+    if (population.row(i)[0] != castles[i].id ||
+        population.row(i)[dimension - 1] != castles[i].id ||
+        population.fitness_at(i) != castles[i].fitness ||
+        population.war_exhaustion_at(i) != castles[i].war_exhaustion) {
+      check(false, "Wrong sorted order");
+      break;
+    }
+  }
+
+  vector<double> king(dimension, -1.0);
+  population.set_row(3, king.data(), -1.0);
+  Knight knight = population.knight(3);
+  check(knight.size() == (int)dimension && knight.data()[0] == -1.0 &&
+            population.fitness_at(3) == -1.0 &&
+            population.war_exhaustion_at(3) == 0,
+        "Wrong replaced row");
+
+  PopulationMatrix other(dimension);
+  other.push_back(population, 3);
+  other.swap(population);
+  check(population.size() == 1 && other.size() == rows &&
+            population.row(0)[0] == -1.0,
+        "Wrong swap");
+
+  cout << (errors == 0 ? "OK" : "FAILED") << endl;
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,73 @@
+extern "C" {
+#include "cec17_test_func.h"
+}
+#include "inc/profiler.h"
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Test of the profiler: nothing is recorded while it is disabled, and once
+ * enabled every evaluation is counted in its function and dimension, in the
+ * histogram, and in the phase that was running.
+ */
+
+int main() {
+  vector<double> x(100 * 30, 1.0), f(100);
+  cec17_profile_stats stats;
+  int errors = 0;
+
+  cec17_test_func(x.data(), f.data(), 10, 100, 1);
+  if (cec17_profile_get(1, 10, &stats)) {
+    cerr << "Evaluations recorded while disabled" << endl;
+    errors++;
+  }
+
+  Profiler::reset();
+  Profiler::enable(true);
+  {
+    ScopedPhase phase(Phase::Siege);
+    cec17_test_func(x.data(), f.data(), 10, 100, 1);
+    cec17_test_func(x.data(), f.data(), 30, 7, 5);
+    for (int i = 0; i < 3; i++) {
+      cec17_test_func(x.data(), f.data(), 30, 1, 5);
+    }
+  }
+  Profiler::enable(false);
+
+  const int funcs[] = {1, 5}, dims[] = {10, 30};
+  const uint64_t evaluations[] = {100, 10}, calls[] = {1, 4};
+  for (int k = 0; k < 2; k++) {
+    uint64_t total = 0;
+
+    cec17_profile_get(funcs[k], dims[k], &stats);
+    for (uint64_t count : stats.histogram) {
+      total += count;
+    }
+    if (stats.evaluations != evaluations[k] || stats.calls != calls[k] ||
+        total != evaluations[k] || stats.cycles == 0) {
+      cerr << "F" << funcs[k] << " D" << dims[k] << ": wrong counters" << endl;
+      errors++;
+    }
+  }
+
+  if (Profiler::calls(Phase::Siege) != 1 ||
+      Profiler::cycles(Phase::Siege) < Profiler::evaluation_cycles()) {
+    cerr << "Wrong phase counters" << endl;
+    errors++;
+  }
+
+  Profiler::summary(cout);
+  cec17_profile_print(stdout);
+
+  Profiler::reset();
+  if (cec17_profile_get(1, 10, &stats) || Profiler::calls(Phase::Siege) != 0) {
+    cerr << "Counters not reset" << endl;
+    errors++;
+  }
+
+  cout << (errors == 0 ? "OK" : "FAILED") << endl;
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
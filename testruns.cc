@@ -0,0 +1,98 @@
+#include "inc/csea.h"
+#include "inc/random.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sys/stat.h>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using Random = effolkronium::random_thread_local;
+
+/**
+ * Test of concurrent runs: several runs of the generation pipeline of csea()
+ * at once, each one in its own thread with its own cec17 session, seed,
+ * buffers and fitness cache, must end with the same population, best knight
+ * and cache hits as running them one by one.
+ */
+
+static const int functions[] = {1, 5, 10};
+static const int num_runs = sizeof(functions) / sizeof(functions[0]);
+static const int generations = 30;
+
+struct Run {
+  vector<double> population;
+  CSEAResult result;
+  unsigned long hits;
+};
+
+static Run run(int r) {
+  CSEAArgs args(20, 10, 1000000, 0.005, 100.0, 1e-6, 4096);
+  cec17_session *session =
+      cec17_session_init("testruns", functions[r], args.dimension, 0);
+  cec17_use_session(session);
+  Random::seed(r);
+
+  CSEABuffers buffers(args);
+  PopulationMatrix population = generate_initial_population(
+      args.population_size, args.dimension, buffers.cache);
+  population.sort();
+  CSEAResult result = {population.knight(0), population.fitness_at(0), 0,
+                       args.population_size};
+  for (int g = 0; g < generations; ++g) {
+    generate_new_generation(population, args, buffers);
+    // The crossover may leave the bounds, which the evaluation rejects
+    PopulationMatrix &knights = buffers.knights;
+    for (size_t k = 0; k < knights.size() * args.dimension; ++k) {
+      double &gene = knights.row(0)[k];
+      gene = min(100.0, max(-100.0, gene));
+    }
+    siege_castles(population, knights, result, buffers.cache);
+    form_alliances(population, args.epsilon, result, buffers);
+    complete_population(population, args, result, buffers.cache);
+    result.generation++;
+  }
+
+  cec17_use_session(NULL);
+  cec17_session_destroy(session);
+  const double *genes = population.row(0);
+  return {vector<double>(genes, genes + population.size() * args.dimension),
+          result, buffers.cache.hits()};
+}
+
+int main() {
+  vector<Run> serial,
+      parallel(num_runs, {{}, {Knight(0, false), 0.0, 0, 0}, 0});
+  vector<thread> threads;
+  int errors = 0;
+
+  mkdir("results_testruns", 0755);
+  for (int r = 0; r < num_runs; r++) {
+    serial.push_back(run(r));
+  }
+  for (int r = 0; r < num_runs; r++) {
+    threads.emplace_back([&, r]() { parallel[r] = run(r); });
+  }
+  for (thread &t : threads) {
+    t.join();
+  }
+
+  for (int r = 0; r < num_runs; r++) {
+    const CSEAResult &a = serial[r].result, &b = parallel[r].result;
+    bool same_knight =
+        a.best_knight.size() == b.best_knight.size() &&
+        !memcmp(a.best_knight.data(), b.best_knight.data(),
+                a.best_knight.size() * sizeof(double));
+    if (serial[r].population != parallel[r].population || !same_knight ||
+        a.fitness != b.fitness || a.evaluations != b.evaluations ||
+        serial[r].hits != parallel[r].hits) {
+      cerr << "F" << functions[r] << ": different concurrent run" << endl;
+      errors++;
+    }
+  }
+
+  cout << (errors == 0 ? "OK" : "FAILED") << endl;
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,180 @@
+extern "C" {
+#include "cec17.h"
+#include "cec17_test_func.h"
+}
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Test of the evaluation sessions: several runs in their own threads, plus
+ * one session shared by four threads, must count every evaluation, keep the
+ * best fitness of a serial evaluation, stop counting at the budget and write
+ * the 14 milestones of each run to its own file, also when a run finishes
+ * before its budget.
+ */
+
+static const int functions[] = {1, 4, 7, 11, 20, 21, 26, 30};
+static const int dimension = 10;
+static const long budget = 2000;
+
+static vector<double> random_solutions(uint64_t state, int rows) {
+  vector<double> x(rows * dimension);
+
+  for (double &value : x) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    value = (2.0 * (double)(state >> 11) / 9007199254740992.0 - 1.0) * 100.0;
+  }
+  return x;
+}
+
+static double serial_best(int funcid, const vector<double> &x) {
+  int rows = x.size() / dimension;
+  cec17_context *ctx = cec17_context_create(funcid, dimension);
+  vector<double> f(rows);
+  double best = INFINITY;
+
+  cec17_context_evaluate(ctx, const_cast<double *>(x.data()), f.data(), rows);
+  cec17_context_destroy(ctx);
+  for (double value : f) {
+    best = fmin(best, value);
+  }
+  return best;
+}
+
+static int count_lines(const string &fname) {
+  ifstream file(fname);
+  string line;
+  int lines = 0;
+
+  while (getline(file, line)) {
+    lines++;
+  }
+  return lines;
+}
+
+static string result_file(int funcid) {
+  return "results_testsession/results_" + to_string(funcid) + "_" +
+         to_string(dimension) + ".txt";
+}
+
+int main() {
+  int num = sizeof(functions) / sizeof(functions[0]);
+  vector<cec17_session *> sessions(num);
+  vector<vector<double>> solutions(num);
+  vector<thread> threads;
+  int errors = 0;
+
+  mkdir("results_testsession", 0755);
+  unlink(result_file(5).c_str());
+  unlink(result_file(9).c_str());
+  for (int i = 0; i < num; i++) {
+    unlink(result_file(functions[i]).c_str());
+    sessions[i] = cec17_session_init("testsession", functions[i], dimension,
+                                     budget);
+    solutions[i] = random_solutions(0x9E3779B97F4A7C15ull + i, budget);
+  }
+
+  /* One run per thread, through the functions without a session argument */
+  for (int i = 0; i < num; i++) {
+    threads.emplace_back([&, i]() {
+      vector<double> f(50);
+
+      cec17_use_session(sessions[i]);
+      for (long row = 0; row < budget; row += 50) {
+        if (row % 100 == 0) {
+          cec17_fitness_batch(&solutions[i][row * dimension], f.data(), 50);
+        } else {
+          for (long k = row; k < row + 50; k++) {
+            cec17_fitness(&solutions[i][k * dimension]);
+          }
+        }
+      }
+      cec17_use_session(NULL);
+    });
+  }
+  for (thread &t : threads) {
+    t.join();
+  }
+  threads.clear();
+
+  for (int i = 0; i < num; i++) {
+    double best = serial_best(functions[i], solutions[i]);
+
+    if (cec17_session_evaluations(sessions[i]) != budget ||
+        cec17_session_best(sessions[i]) != best) {
+      cerr << "F" << functions[i] << ": wrong count or best" << endl;
+      errors++;
+    }
+    cec17_session_destroy(sessions[i]);
+    if (count_lines(result_file(functions[i])) != 15) {
+      cerr << "F" << functions[i] << ": wrong milestones" << endl;
+      errors++;
+    }
+  }
+
+  /* One run shared by four threads, with one evaluation over the budget */
+  cec17_session *shared = cec17_session_init("testsession", 5, dimension, 400);
+  vector<double> x = random_solutions(12345, 400);
+
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&, t]() {
+      for (int k = t * 100; k < (t + 1) * 100; k++) {
+        cec17_session_fitness(shared, &x[k * dimension]);
+      }
+    });
+  }
+  for (thread &t : threads) {
+    t.join();
+  }
+  cec17_session_record(shared, 0.0);
+  if (cec17_session_evaluations(shared) != 400 ||
+      cec17_session_best(shared) != serial_best(5, x)) {
+    cerr << "Shared session: wrong count or best" << endl;
+    errors++;
+  }
+  cec17_session_destroy(shared);
+
+  /* A run that stops early still writes every milestone, with its error */
+  cec17_session *early = cec17_session_init("testsession", 9, dimension, 400);
+  vector<double> y = random_solutions(54321, 30);
+
+  for (int k = 0; k < 30; k++) {
+    cec17_session_fitness(early, &y[k * dimension]);
+  }
+  cec17_session_finish(early);
+  string last = "9," + to_string(dimension) + ",100,";
+  char error[32];
+  snprintf(error, sizeof(error), "%e",
+           cec17_session_error(early, serial_best(9, y)));
+  if (cec17_session_evaluations(early) != 400) {
+    cerr << "Finished session: wrong count" << endl;
+    errors++;
+  }
+  cec17_session_destroy(early);
+  ifstream file(result_file(9));
+  string line;
+  int lines = 0;
+  for (string next; getline(file, next); lines++) {
+    line = next;
+  }
+  if (lines != 15 || line != last + error) {
+    cerr << "Finished session: wrong milestones" << endl;
+    errors++;
+  }
+
+  cout << (errors == 0 ? "OK" : "FAILED") << endl;
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,80 @@
+extern "C" {
+#include "cec17_test_func.h"
+}
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Validation of the vectorised kernels (CEC17_SIMD option): for every
+ * function and dimension, reports the maximum absolute and relative error of
+ * the vectorised evaluation against the scalar one. It fails when a relative
+ * error is greater than the tolerance given as argument (1e-10 by default).
+ */
+int main(int argc, char *argv[]) {
+  double tolerance = argc > 1 ? atof(argv[1]) : 1e-10;
+  int dims[] = {2, 10, 20, 30, 50, 100};
+  int num_solutions = 200;
+  int errors = 0;
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<> dis(-100.0, 100.0);
+
+  cout << setw(4) << "F" << setw(5) << "D" << setw(14) << "max abs"
+       << setw(14) << "max rel" << endl;
+
+  for (int dim : dims) {
+    vector<double> sol(num_solutions * dim);
+
+    for (auto &value : sol) {
+      value = dis(gen);
+    }
+
+    for (int funcid = 1; funcid <= 30; funcid++) {
+      if (dim == 2 && ((funcid >= 17 && funcid <= 22) || funcid >= 29)) {
+        continue; // not defined for D=2
+      }
+
+      cec17_context *ctx = cec17_context_create(funcid, dim);
+
+      if (ctx == NULL) {
+        continue;
+      }
+
+      if (cec17_context_set_flags(ctx, CEC17_FLAG_SIMD) == 0) {
+        cout << "Library built without the CEC17_SIMD option" << endl;
+        cec17_context_destroy(ctx);
+        return EXIT_SUCCESS;
+      }
+
+      vector<double> scalar(num_solutions), simd(num_solutions);
+      cec17_context_evaluate(ctx, &sol[0], &simd[0], num_solutions);
+      cec17_context_set_flags(ctx, 0);
+      cec17_context_evaluate(ctx, &sol[0], &scalar[0], num_solutions);
+      cec17_context_destroy(ctx);
+
+      double max_abs = 0, max_rel = 0;
+
+      for (int i = 0; i < num_solutions; i++) {
+        double error = fabs(simd[i] - scalar[i]);
+        max_abs = max(max_abs, error);
+        max_rel = max(max_rel, error / fabs(scalar[i]));
+      }
+
+      cout << setw(4) << funcid << setw(5) << dim << scientific
+           << setprecision(3) << setw(14) << max_abs << setw(14) << max_rel
+           << defaultfloat << endl;
+
+      if (!(max_rel <= tolerance)) {
+        errors++;
+      }
+    }
+  }
+
+  cout << (errors == 0 ? "OK" : "FAILED") << endl;
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,132 @@
+extern "C" {
+#include "cec17.h"
+}
+#include "inc/trace_reader.h"
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <csignal>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Test of the convergence traces: a run traced every 100 evaluations and
+ * another one traced per generation, appended to the same file, must read
+ * back with their rows in order, a non-increasing error and the same
+ * milestones as the results file. A run killed by a signal must still write
+ * the rows it kept in memory.
+ */
+
+static const int dimension = 10;
+static const long budget = 2000;
+static const char *results = "results_testtrace/results_3_10.txt";
+static const char *trace = "results_testtrace/trace.bin";
+static const char *killed = "results_testtrace/killed.bin";
+
+static void run(cec17_session *session, uint64_t state, long evaluations) {
+  vector<double> x(dimension);
+
+  for (long k = 0; k < evaluations; k++) {
+    if (k % 25 == 0) {
+      cec17_session_generation(session, k / 25);
+    }
+    for (double &value : x) {
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      value = (2.0 * (double)(state >> 11) / 9007199254740992.0 - 1.0) * 100.0;
+    }
+    cec17_session_fitness(session, x.data());
+  }
+}
+
+int main() {
+  int errors = 0;
+
+  mkdir("results_testtrace", 0755);
+  unlink(results);
+  unlink(trace);
+  for (long every : {100L, 0L}) {
+    cec17_session *session =
+        cec17_session_init("testtrace", 3, dimension, budget);
+    cec17_session_trace(session, trace, every);
+    run(session, 0x9E3779B97F4A7C15ull + every, budget);
+    cec17_session_destroy(session);
+  }
+
+  TraceReader reader(trace);
+  ifstream file(results);
+  stringstream lines;
+  string header;
+
+  getline(file, header);
+  lines << file.rdbuf();
+
+  // 20 rows every 100 evaluations plus the milestones at 20, 40 and 60, and
+  // one row per generation without a milestone row
+  const size_t expected[] = {23, 83};
+  if (!reader.is_open() || reader.runs().size() != 2) {
+    cerr << "Wrong number of runs" << endl;
+    return EXIT_FAILURE;
+  }
+  for (size_t r = 0; r < 2; r++) {
+    const TraceRun &run = reader.runs()[r];
+    long last = 0;
+    double error = 1e300;
+
+    if (run.funcid != 3 || run.dimension != dimension ||
+        run.max_evaluations != budget || run.rows != expected[r]) {
+      cerr << "Run " << r << ": wrong header or rows" << endl;
+      errors++;
+    }
+    for (const TraceBlock &block : run.blocks) {
+      for (size_t i = 0; i < block.rows; i++) {
+        if (block.evaluation[i] <= last || block.error[i] > error) {
+          cerr << "Run " << r << ": rows out of order" << endl;
+          errors++;
+        }
+        last = block.evaluation[i];
+        error = block.error[i];
+      }
+    }
+  }
+
+  // Both runs write their milestones to the same results file
+  if (TraceReader::milestones_csv(reader.runs()[0]) +
+          TraceReader::milestones_csv(reader.runs()[1]) !=
+      lines.str()) {
+    cerr << "Milestones differ from the results file" << endl;
+    errors++;
+  }
+
+  // Killed at 1500 evaluations, with its 18 rows (15 every 100 evaluations
+  // plus three milestones) still in memory
+  unlink(killed);
+  pid_t child = fork();
+  if (child == 0) {
+    cec17_session *session =
+        cec17_session_init("testtrace_killed", 3, dimension, budget);
+    cec17_session_trace(session, killed, 100);
+    run(session, 0x9E3779B97F4A7C15ull, 1500);
+    raise(SIGTERM);
+    _exit(EXIT_SUCCESS);
+  }
+  int status = 0;
+  waitpid(child, &status, 0);
+  TraceReader partial(killed);
+  if (!WIFSIGNALED(status) || !partial.is_open() ||
+      partial.runs().size() != 1 || partial.runs()[0].rows != 18) {
+    cerr << "Rows of the killed run lost" << endl;
+    errors++;
+  }
+
+  cout << (errors == 0 ? "OK" : "FAILED") << endl;
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}